@@ -0,0 +1,144 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    gaussian_elimination.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Solution of small dense linear systems
+ *
+ * Gaussian elimination with partial pivoting on stack storage, for the
+ * normal equations of algebraic sphere and circle fits and the
+ * intersections of tangent planes. Unlike a Cholesky decomposition, it
+ * does not require a symmetric positive definite matrix.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__gaussian_elimination_h__
+#define __rrlib__model_fitting__gaussian_elimination_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * \brief Solve A * x = b in place
+ *
+ * \param a                 The matrix, which is destroyed
+ * \param b                 The right hand side, which is replaced by the solution x
+ * \param pivot_threshold   Pivots with smaller magnitude relative to the largest entry of A make the system singular
+ *
+ * \return Whether the system had a unique solution
+ */
+template <size_t Tsize>
+const bool SolveLinearSystem(double(&a)[Tsize][Tsize], double(&b)[Tsize], double pivot_threshold = 1E-12)
+{
+  double max_entry = 0;
+  for (size_t i = 0; i < Tsize; ++i)
+  {
+    for (size_t j = 0; j < Tsize; ++j)
+    {
+      max_entry = std::max(max_entry, std::fabs(a[i][j]));
+    }
+  }
+  if (max_entry == 0)
+  {
+    return false;
+  }
+
+  for (size_t k = 0; k < Tsize; ++k)
+  {
+    size_t pivot = k;
+    for (size_t i = k + 1; i < Tsize; ++i)
+    {
+      if (std::fabs(a[i][k]) > std::fabs(a[pivot][k]))
+      {
+        pivot = i;
+      }
+    }
+    if (std::fabs(a[pivot][k]) <= pivot_threshold * max_entry)
+    {
+      return false;
+    }
+    if (pivot != k)
+    {
+      for (size_t j = k; j < Tsize; ++j)
+      {
+        std::swap(a[k][j], a[pivot][j]);
+      }
+      std::swap(b[k], b[pivot]);
+    }
+
+    for (size_t i = k + 1; i < Tsize; ++i)
+    {
+      double factor = a[i][k] / a[k][k];
+      for (size_t j = k + 1; j < Tsize; ++j)
+      {
+        a[i][j] -= factor * a[k][j];
+      }
+      b[i] -= factor * b[k];
+    }
+  }
+
+  for (size_t k = Tsize; k-- > 0;)
+  {
+    for (size_t j = k + 1; j < Tsize; ++j)
+    {
+      b[k] -= a[k][j] * b[j];
+    }
+    b[k] /= a[k][k];
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
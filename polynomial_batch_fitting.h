@@ -0,0 +1,259 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    polynomial_batch_fitting.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Least squares fitting of many small polynomials in one call
+ *
+ * The polynomials are processed in blocks of Tlanes. Within a block the
+ * normal equations of all polynomials are accumulated side by side and
+ * decomposed with the same loop nest that tPolynomialMoments uses, but
+ * with the polynomial index as the innermost, branch-free loop, so that
+ * the compiler can map it to SIMD lanes. Polynomials are grouped into
+ * blocks by similar sample count to keep the lanes busy.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__polynomial_batch_fitting_h__
+#define __rrlib__model_fitting__polynomial_batch_fitting_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * \brief Fit independent polynomials of the same degree to ragged sample ranges
+ *
+ * The samples of polynomial p are x[i], y[i] for offsets[p] <= i < offsets[p + 1].
+ * Like tLeastSquaresPolynomial, each lane maps its x values to [-1, 1]
+ * before accumulating power sums and expands the solution afterwards, so
+ * that the results match it also for short ranges far from zero:
+ * coefficients in increasing order and sigma as the standard deviation
+ * of the residuals.
+ *
+ * \param x                        The x values of all samples
+ * \param y                        The y values of all samples
+ * \param offsets                  number_of_polynomials + 1 non-decreasing offsets into x and y
+ * \param number_of_polynomials    The number of polynomials to fit
+ * \param coefficients             Output array of number_of_polynomials * (Tdegree + 1) coefficients
+ * \param sigmas                   Output array of number_of_polynomials standard deviations (may be NULL)
+ * \param valid                    Output array of number_of_polynomials flags that are 0 for fits with a singular normal matrix (may be NULL)
+ *
+ * \return The number of successful fits
+ */
+template <size_t Tdegree, size_t Tlanes = 8>
+size_t FitPolynomialBatch(const double *x, const double *y, const size_t *offsets, size_t number_of_polynomials,
+                          double *coefficients, double *sigmas = NULL, unsigned char *valid = NULL)
+{
+  // group polynomials with similar sample counts into the same block
+  std::vector<size_t> order(number_of_polynomials);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [offsets](size_t a, size_t b)
+  {
+    return offsets[a + 1] - offsets[a] < offsets[b + 1] - offsets[b];
+  });
+
+  size_t number_of_successful_fits = 0;
+  for (size_t block = 0; block < number_of_polynomials; block += Tlanes)
+  {
+    size_t first[Tlanes];
+    size_t count[Tlanes];
+    double x_offset[Tlanes];
+    double x_scale[Tlanes];
+    size_t max_count = 0;
+    for (size_t lane = 0; lane < Tlanes; ++lane)
+    {
+      size_t polynomial = order[std::min(block + lane, number_of_polynomials - 1)];
+      first[lane] = offsets[polynomial];
+      count[lane] = block + lane < number_of_polynomials ? offsets[polynomial + 1] - offsets[polynomial] : 0;
+      max_count = std::max(max_count, count[lane]);
+
+      double x_min = count[lane] > 0 ? x[first[lane]] : 0.0;
+      double x_max = x_min;
+      for (size_t i = first[lane]; i < first[lane] + count[lane]; ++i)
+      {
+        x_min = std::min(x_min, x[i]);
+        x_max = std::max(x_max, x[i]);
+      }
+      tLeastSquaresPolynomial<Tdegree>::GetIntervalNormalization(x_min, x_max, x_offset[lane], x_scale[lane]);
+    }
+
+    // accumulate S(x^k), S(x^k*y) and S(y^2) of normalized x for all lanes
+    double power_sums[2 * Tdegree + 1][Tlanes] = {};
+    double mixed_power_sums[Tdegree + 1][Tlanes] = {};
+    double square_sums[Tlanes] = {};
+    for (size_t i = 0; i < max_count; ++i)
+    {
+      for (size_t lane = 0; lane < Tlanes; ++lane)
+      {
+        // lanes that ran out of samples reread their first one with zero weight
+        double weight = i < count[lane] ? 1.0 : 0.0;
+        size_t index = first[lane] + (i < count[lane] ? i : 0);
+        double xi = count[lane] > 0 ? (x[index] - x_offset[lane]) / x_scale[lane] : 0.0;
+        double yi = count[lane] > 0 ? y[index] : 0.0;
+        double power = weight;
+        for (size_t k = 0; k < Tdegree + 1; ++k)
+        {
+          power_sums[k][lane] += power;
+          mixed_power_sums[k][lane] += power * yi;
+          power *= xi;
+        }
+        for (size_t k = Tdegree + 1; k < 2 * Tdegree + 1; ++k)
+        {
+          power_sums[k][lane] += power;
+          power *= xi;
+        }
+        square_sums[lane] += weight * yi * yi;
+      }
+    }
+
+    // decompose all normal matrices into L*L^T and solve L*z = S(x^k*y)
+    double l[Tdegree + 1][Tdegree + 1][Tlanes];
+    double z[Tdegree + 1][Tlanes];
+    double solvable[Tlanes];
+    for (size_t lane = 0; lane < Tlanes; ++lane)
+    {
+      solvable[lane] = 1.0;
+    }
+    for (size_t row = 0; row < Tdegree + 1; ++row)
+    {
+      for (size_t column = 0; column <= row; ++column)
+      {
+        for (size_t lane = 0; lane < Tlanes; ++lane)
+        {
+          double sum = power_sums[row + column][lane];
+          for (size_t k = 0; k < column; ++k)
+          {
+            sum -= l[row][k][lane] * l[column][k][lane];
+          }
+          if (row == column)
+          {
+            // singular lanes continue with a unit pivot and are discarded afterwards
+            double positive = sum > 0 ? 1.0 : 0.0;
+            solvable[lane] *= positive;
+            l[row][row][lane] = positive > 0 ? std::sqrt(sum) : 1.0;
+          }
+          else
+          {
+            l[row][column][lane] = sum / l[column][column][lane];
+          }
+        }
+      }
+      for (size_t lane = 0; lane < Tlanes; ++lane)
+      {
+        double sum = mixed_power_sums[row][lane];
+        for (size_t k = 0; k < row; ++k)
+        {
+          sum -= l[row][k][lane] * z[k][lane];
+        }
+        z[row][lane] = sum / l[row][row][lane];
+      }
+    }
+
+    // back substitution L^T*a = z
+    double solution[Tdegree + 1][Tlanes];
+    for (size_t row = Tdegree + 1; row-- > 0;)
+    {
+      for (size_t lane = 0; lane < Tlanes; ++lane)
+      {
+        double sum = z[row][lane];
+        for (size_t k = row + 1; k < Tdegree + 1; ++k)
+        {
+          sum -= l[k][row][lane] * solution[k][lane];
+        }
+        solution[row][lane] = sum / l[row][row][lane];
+      }
+    }
+
+    for (size_t lane = 0; lane < Tlanes && block + lane < number_of_polynomials; ++lane)
+    {
+      size_t polynomial = order[block + lane];
+      bool success = solvable[lane] > 0;
+      math::tVector < Tdegree + 1, double > normalized_coefficients;
+      for (size_t k = 0; k < Tdegree + 1; ++k)
+      {
+        normalized_coefficients[k] = solution[k][lane];
+      }
+      math::tPolynomial<Tdegree> expanded_polynomial;
+      tLeastSquaresPolynomial<Tdegree>::ExpandNormalizedPolynomial(normalized_coefficients, x_offset[lane], x_scale[lane], expanded_polynomial);
+      for (size_t k = 0; k < Tdegree + 1; ++k)
+      {
+        coefficients[polynomial * (Tdegree + 1) + k] = success ? expanded_polynomial.GetCoefficient(k) : 0.0;
+      }
+      if (sigmas)
+      {
+        // the residual sum of squares of the optimum is S(y^2) - |z|^2
+        double residual_sum_of_squares = square_sums[lane];
+        for (size_t k = 0; k < Tdegree + 1; ++k)
+        {
+          residual_sum_of_squares -= z[k][lane] * z[k][lane];
+        }
+        sigmas[polynomial] = success && count[lane] > 1 ? std::sqrt(std::max(residual_sum_of_squares, 0.0) / (count[lane] - 1)) : 0.0;
+      }
+      if (valid)
+      {
+        valid[polynomial] = success;
+      }
+      number_of_successful_fits += success;
+    }
+  }
+
+  return number_of_successful_fits;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
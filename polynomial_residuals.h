@@ -0,0 +1,173 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    polynomial_residuals.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Batch residual kernels for polynomial models
+ *
+ * Polynomials are evaluated with loops that are unrolled for the
+ * compile-time degree (Horner's scheme for univariate ones), so that the
+ * loop over the contiguous coordinate arrays can be vectorized by the
+ * compiler.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__polynomial_residuals_h__
+#define __rrlib__model_fitting__polynomial_residuals_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <cmath>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * \brief Compute |yi - p(xi)| for n samples
+ *
+ * \param coefficients   The coefficients of p in increasing order
+ * \param x              The x values of the samples
+ * \param y              The y values of the samples
+ * \param n              The number of samples
+ * \param errors         The output array of n residuals
+ */
+template <size_t Tdegree>
+inline void EvaluatePolynomialResiduals(const double(&coefficients)[Tdegree + 1],
+                                        const double *__restrict__ x, const double *__restrict__ y, size_t n,
+                                        double *__restrict__ errors)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    double value = coefficients[Tdegree];
+    for (size_t k = Tdegree; k-- > 0;)
+    {
+      value = value * x[i] + coefficients[k];
+    }
+    errors[i] = std::fabs(y[i] - value);
+  }
+}
+
+/*!
+ * \brief Determine the inliers of p among n samples
+ *
+ * \param coefficients         The coefficients of p in increasing order
+ * \param x                    The x values of the samples
+ * \param y                    The y values of the samples
+ * \param n                    The number of samples
+ * \param max_error            The maximal residual of an inlier
+ * \param inlier_mask          The output array of n flags (1 for inliers, 0 otherwise)
+ * \param total_inlier_error   The sum of the residuals of all inliers
+ *
+ * \return The number of inliers
+ */
+template <size_t Tdegree>
+inline size_t CountPolynomialInliers(const double(&coefficients)[Tdegree + 1],
+                                     const double *__restrict__ x, const double *__restrict__ y, size_t n,
+                                     double max_error, unsigned char *__restrict__ inlier_mask, double &total_inlier_error)
+{
+  size_t number_of_inliers = 0;
+  double error_sum = 0;
+  for (size_t i = 0; i < n; ++i)
+  {
+    double value = coefficients[Tdegree];
+    for (size_t k = Tdegree; k-- > 0;)
+    {
+      value = value * x[i] + coefficients[k];
+    }
+    double error = std::fabs(y[i] - value);
+    unsigned char inlier = error <= max_error;
+    inlier_mask[i] = inlier;
+    number_of_inliers += inlier;
+    error_sum += inlier ? error : 0.0;
+  }
+  total_inlier_error = error_sum;
+  return number_of_inliers;
+}
+
+/*!
+ * \brief Compute |zi - f(xi, yi)| for n samples of a bivariate polynomial surface
+ *
+ * \param coefficients   The coefficients of f in graded order 1, x, y, x^2, x*y, y^2, ...
+ * \param x              The x values of the samples
+ * \param y              The y values of the samples
+ * \param z              The z values of the samples
+ * \param n              The number of samples
+ * \param errors         The output array of n residuals
+ */
+template <size_t Tdegree>
+inline void EvaluatePolynomialSurfaceResiduals(const double(&coefficients)[(Tdegree + 1) * (Tdegree + 2) / 2],
+    const double *__restrict__ x, const double *__restrict__ y, const double *__restrict__ z, size_t n,
+    double *__restrict__ errors)
+{
+  for (size_t i = 0; i < n; ++i)
+  {
+    double x_powers[Tdegree + 1];
+    double y_powers[Tdegree + 1];
+    x_powers[0] = 1;
+    y_powers[0] = 1;
+    for (size_t k = 1; k < Tdegree + 1; ++k)
+    {
+      x_powers[k] = x_powers[k - 1] * x[i];
+      y_powers[k] = y_powers[k - 1] * y[i];
+    }
+    double value = 0;
+    size_t term = 0;
+    for (size_t total_degree = 0; total_degree < Tdegree + 1; ++total_degree)
+    {
+      for (size_t y_exponent = 0; y_exponent <= total_degree; ++y_exponent, ++term)
+      {
+        value += coefficients[term] * x_powers[total_degree - y_exponent] * y_powers[y_exponent];
+      }
+    }
+    errors[i] = std::fabs(z[i] - value);
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
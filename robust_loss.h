@@ -0,0 +1,150 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    robust_loss.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Weight functions of robust M-estimators and robust scale estimation
+ *
+ * The weights are those of iteratively reweighted least squares,
+ * i.e. w(r) = psi(r) / r, for residuals r relative to a scale s. The
+ * tuning constants give 95% efficiency for Gaussian noise.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__robust_loss_h__
+#define __rrlib__model_fitting__robust_loss_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+enum class tRobustLoss
+{
+  HUBER,   //!< Quadratic up to 1.345 s, linear beyond (convex, never rejects a sample completely)
+  TUKEY,   //!< Tukey's biweight with cutoff 4.685 s (redescending, rejects gross outliers)
+  CAUCHY   //!< Logarithmic with constant 2.385 s (redescending, but never reaches zero)
+};
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * \brief The IRLS weight of a residual
+ *
+ * \param loss       The loss function
+ * \param residual   The residual of the sample
+ * \param scale      The scale of the inlier residuals. For scale 0 only exact fits get a non-zero weight.
+ *
+ * \return The weight in [0, 1]
+ */
+inline double GetRobustWeight(tRobustLoss loss, double residual, double scale)
+{
+  double c = 0;
+  switch (loss)
+  {
+  case tRobustLoss::HUBER:
+    c = 1.345;
+    break;
+  case tRobustLoss::TUKEY:
+    c = 4.685;
+    break;
+  case tRobustLoss::CAUCHY:
+    c = 2.385;
+    break;
+  }
+
+  double u = scale > 0 ? std::fabs(residual) / (c * scale) : (residual == 0 ? 0.0 : std::numeric_limits<double>::infinity());
+
+  switch (loss)
+  {
+  case tRobustLoss::HUBER:
+    return u <= 1 ? 1.0 : 1.0 / u;
+  case tRobustLoss::TUKEY:
+    return u < 1 ? (1 - u * u) * (1 - u * u) : 0.0;
+  case tRobustLoss::CAUCHY:
+    return 1.0 / (1 + u * u);
+  }
+  return 0;
+}
+
+/*!
+ * \brief Robust estimate of the standard deviation of residuals from their median absolute value
+ *
+ * \param residuals   The residuals (passed by value as they are partially sorted)
+ *
+ * \return 1.4826 * median(|ri|), which is consistent with sigma for Gaussian noise
+ */
+inline double GetMedianAbsoluteDeviationScale(std::vector<double> residuals)
+{
+  if (residuals.empty())
+  {
+    return 0;
+  }
+  for (std::vector<double>::iterator it = residuals.begin(); it != residuals.end(); ++it)
+  {
+    *it = std::fabs(*it);
+  }
+  std::vector<double>::iterator median = residuals.begin() + residuals.size() / 2;
+  std::nth_element(residuals.begin(), median, residuals.end());
+  double result = *median;
+  if (residuals.size() % 2 == 0)
+  {
+    result = 0.5 * (result + *std::max_element(residuals.begin(), median));
+  }
+  return 1.4826 * result;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
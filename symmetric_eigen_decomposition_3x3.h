@@ -0,0 +1,160 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    symmetric_eigen_decomposition_3x3.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Eigen decomposition of symmetric 3x3 matrices
+ *
+ * Cyclic Jacobi rotations on stack storage. For 3x3 matrices this
+ * converges quadratically and typically needs four to six sweeps. Unlike
+ * the closed-form trigonometric solution, it keeps full accuracy for the
+ * eigenvectors of nearly equal eigenvalues, which matters for the normals
+ * of noisy planes.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__symmetric_eigen_decomposition_3x3_h__
+#define __rrlib__model_fitting__symmetric_eigen_decomposition_3x3_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Function declarations
+//----------------------------------------------------------------------
+
+/*!
+ * \brief Decompose a symmetric 3x3 matrix A into V^T * diag(eigenvalues) * V
+ *
+ * \param matrix         The symmetric matrix (only the upper triangle is used)
+ * \param eigenvalues    The eigenvalues in ascending order
+ * \param eigenvectors   The corresponding orthonormal eigenvectors as rows
+ */
+template <typename TElement>
+void DecomposeSymmetric3x3(const TElement(&matrix)[3][3], TElement(&eigenvalues)[3], TElement(&eigenvectors)[3][3])
+{
+  TElement a[3][3];
+  TElement v[3][3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = 0; j < 3; ++j)
+    {
+      a[i][j] = matrix[std::min(i, j)][std::max(i, j)];
+      v[i][j] = i == j ? 1 : 0;
+    }
+  }
+
+  for (unsigned int sweep = 0; sweep < 50; ++sweep)
+  {
+    TElement off_diagonal = std::fabs(a[0][1]) + std::fabs(a[0][2]) + std::fabs(a[1][2]);
+    TElement diagonal = std::fabs(a[0][0]) + std::fabs(a[1][1]) + std::fabs(a[2][2]);
+    if (off_diagonal <= std::numeric_limits<TElement>::epsilon() * diagonal || off_diagonal == 0)
+    {
+      break;
+    }
+
+    for (size_t p = 0; p < 2; ++p)
+    {
+      for (size_t q = p + 1; q < 3; ++q)
+      {
+        if (a[p][q] == 0)
+        {
+          continue;
+        }
+
+        // rotation that annihilates a[p][q], with the smaller angle for stability
+        TElement theta = (a[q][q] - a[p][p]) / (2 * a[p][q]);
+        TElement t = (theta >= 0 ? 1 : -1) / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+        TElement c = 1 / std::sqrt(t * t + 1);
+        TElement s = t * c;
+
+        for (size_t k = 0; k < 3; ++k)
+        {
+          TElement a_kp = a[k][p];
+          TElement a_kq = a[k][q];
+          a[k][p] = c * a_kp - s * a_kq;
+          a[k][q] = s * a_kp + c * a_kq;
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+          TElement a_pk = a[p][k];
+          TElement a_qk = a[q][k];
+          a[p][k] = c * a_pk - s * a_qk;
+          a[q][k] = s * a_pk + c * a_qk;
+        }
+        for (size_t k = 0; k < 3; ++k)
+        {
+          TElement v_pk = v[p][k];
+          TElement v_qk = v[q][k];
+          v[p][k] = c * v_pk - s * v_qk;
+          v[q][k] = s * v_pk + c * v_qk;
+        }
+      }
+    }
+  }
+
+  size_t order[3] = { 0, 1, 2 };
+  std::sort(order, order + 3, [&a](size_t i, size_t j)
+  {
+    return a[i][i] < a[j][j];
+  });
+  for (size_t i = 0; i < 3; ++i)
+  {
+    eigenvalues[i] = a[order[i]][order[i]];
+    for (size_t k = 0; k < 3; ++k)
+    {
+      eigenvectors[i][k] = v[order[i]][k];
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
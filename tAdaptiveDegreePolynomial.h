@@ -0,0 +1,194 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tAdaptiveDegreePolynomial.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tAdaptiveDegreePolynomial
+ *
+ * \b tAdaptiveDegreePolynomial
+ *
+ * Polynomial least squares regression with model selection over the
+ * degree at runtime.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tAdaptiveDegreePolynomial_h__
+#define __rrlib__model_fitting__tAdaptiveDegreePolynomial_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tPolynomial.h"
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPolynomialMoments.h"
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Least squares polynomial with a degree chosen at runtime
+/*! The power sums are accumulated once up to Tmax_degree. A single
+ *  Cholesky decomposition of the normal matrix of degree Tmax_degree
+ *  contains the decompositions of all lower degrees, so the residual sum
+ *  of squares of every candidate degree comes at no extra cost and only
+ *  the selected degree is back-substituted. The degree is chosen by
+ *  AIC, BIC or k-fold cross-validation, where the latter is also
+ *  evaluated from per-fold power sums.
+ *
+ *  Fits to samples normalize x to [-1, 1] like tLeastSquaresPolynomial,
+ *  so that high candidate degrees stay solvable for x far from zero.
+ *
+ *  Coefficients above Degree() are zero.
+ */
+template <size_t Tmax_degree>
+class tAdaptiveDegreePolynomial : public math::tPolynomial<Tmax_degree>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVec2d tSample;
+  typedef model_fitting::tPolynomialMoments<Tmax_degree> tMoments;
+
+  enum class tCriterion
+  {
+    AIC,               //!< n * ln(RSS / n) + 2 * k
+    BIC,               //!< n * ln(RSS / n) + k * ln(n)
+    CROSS_VALIDATION   //!< Mean squared prediction error of k-fold cross-validation
+  };
+
+  tAdaptiveDegreePolynomial();
+
+  template <typename TIterator>
+  tAdaptiveDegreePolynomial(TIterator begin, TIterator end, tCriterion criterion = tCriterion::BIC, size_t min_degree = 0);
+
+  /*!
+   * \brief Set the number of folds for tCriterion::CROSS_VALIDATION (samples are assigned round-robin)
+   */
+  inline void SetNumberOfFolds(size_t number_of_folds)
+  {
+    assert(number_of_folds > 1);
+    this->number_of_folds = number_of_folds;
+  }
+
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end, tCriterion criterion = tCriterion::BIC, size_t min_degree = 0);
+
+  /*!
+   * \brief Select the degree from given power sums (AIC and BIC only)
+   *
+   * The power sums are used as given, so x should be small (e.g. centered).
+   *
+   * \return Whether a degree could be selected (false for tCriterion::CROSS_VALIDATION)
+   */
+  const bool UpdateModelFromMoments(const tMoments &moments, tCriterion criterion = tCriterion::BIC, size_t min_degree = 0);
+
+  inline size_t Degree() const
+  {
+    return this->degree;
+  }
+
+  inline double GetStandardDeviation() const
+  {
+    return this->sigma;
+  }
+
+  /*!
+   * \brief The value of the criterion for the given degree from the last update (infinity if not solvable)
+   */
+  inline double CriterionValue(size_t degree) const
+  {
+    assert(degree < Tmax_degree + 1);
+    return this->criterion_values[degree];
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  size_t degree;
+  double sigma;
+  size_t number_of_folds;
+  double criterion_values[Tmax_degree + 1];
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tAdaptiveDegreePolynomial";
+  }
+
+  /*!
+   * \brief Determine the criterion values of AIC or BIC from the power sums
+   */
+  void EvaluateInformationCriterion(const tMoments &moments, tCriterion criterion);
+
+  /*!
+   * \brief Determine the criterion values of k-fold cross-validation from per-fold power sums
+   */
+  void EvaluateCrossValidation(const std::vector<tMoments> &folds, const tMoments &moments);
+
+  /*!
+   * \brief Fit the degree with the lowest criterion value
+   *
+   * If the power sums are those of normalized values t = (x - offset) / scale,
+   * the polynomial is converted back to coefficients of x.
+   */
+  const bool Select(const tMoments &moments, size_t min_degree, double offset = 0, double scale = 1);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tAdaptiveDegreePolynomial.hpp"
+
+#endif
@@ -0,0 +1,257 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tAdaptiveDegreePolynomial.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial constructors
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+tAdaptiveDegreePolynomial<Tmax_degree>::tAdaptiveDegreePolynomial()
+  : degree(0),
+    sigma(0),
+    number_of_folds(5)
+{
+  std::fill(this->criterion_values, this->criterion_values + Tmax_degree + 1, std::numeric_limits<double>::infinity());
+}
+
+template <size_t Tmax_degree>
+template <typename TIterator>
+tAdaptiveDegreePolynomial<Tmax_degree>::tAdaptiveDegreePolynomial(TIterator begin, TIterator end, tCriterion criterion, size_t min_degree)
+  : degree(0),
+    sigma(0),
+    number_of_folds(5)
+{
+  if (!this->UpdateModelFromSampleSet(begin, end, criterion, min_degree))
+  {
+    throw std::runtime_error("Failed to fit polynomial during construction!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial UpdateModelFromSampleSet
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+template <typename TIterator>
+const bool tAdaptiveDegreePolynomial<Tmax_degree>::UpdateModelFromSampleSet(TIterator begin, TIterator end, tCriterion criterion, size_t min_degree)
+{
+  double offset;
+  double scale;
+  tLeastSquaresPolynomial<Tmax_degree>::GetNormalization(begin, end, offset, scale);
+
+  if (criterion != tCriterion::CROSS_VALIDATION)
+  {
+    tMoments moments;
+    for (TIterator it = begin; it != end; ++it)
+    {
+      moments.Add(math::tVec2d((it->X() - offset) / scale, it->Y()));
+    }
+    this->EvaluateInformationCriterion(moments, criterion);
+    return this->Select(moments, min_degree, offset, scale);
+  }
+
+  std::vector<tMoments> folds(this->number_of_folds);
+  tMoments moments;
+  size_t i = 0;
+  for (TIterator it = begin; it != end; ++it, ++i)
+  {
+    folds[i % this->number_of_folds].Add(math::tVec2d((it->X() - offset) / scale, it->Y()));
+  }
+  for (typename std::vector<tMoments>::const_iterator it = folds.begin(); it != folds.end(); ++it)
+  {
+    moments += *it;
+  }
+
+  this->EvaluateCrossValidation(folds, moments);
+  return this->Select(moments, min_degree, offset, scale);
+}
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial UpdateModelFromMoments
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+const bool tAdaptiveDegreePolynomial<Tmax_degree>::UpdateModelFromMoments(const tMoments &moments, tCriterion criterion, size_t min_degree)
+{
+  if (criterion == tCriterion::CROSS_VALIDATION)
+  {
+    RRLIB_LOG_PRINT(ERROR, "Cross-validation needs the samples of each fold and cannot be evaluated from power sums!");
+    return false;
+  }
+
+  this->EvaluateInformationCriterion(moments, criterion);
+  return this->Select(moments, min_degree);
+}
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial EvaluateInformationCriterion
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+void tAdaptiveDegreePolynomial<Tmax_degree>::EvaluateInformationCriterion(const tMoments &moments, tCriterion criterion)
+{
+  assert(criterion != tCriterion::CROSS_VALIDATION);
+
+  double l[Tmax_degree + 1][Tmax_degree + 1];
+  double z[Tmax_degree + 1];
+  size_t max_size = moments.DecomposeNormalEquations(l, z);
+
+  const double n = moments.NumberOfSamples();
+  double residual_sum_of_squares = moments.SquareSum();
+  for (size_t d = 0; d < Tmax_degree + 1; ++d)
+  {
+    if (d < max_size)
+    {
+      residual_sum_of_squares -= z[d] * z[d];
+    }
+    if (d >= max_size || d + 1 >= n)
+    {
+      this->criterion_values[d] = std::numeric_limits<double>::infinity();
+      continue;
+    }
+    double k = d + 1;
+    double log_likelihood_term = n * std::log(std::max(residual_sum_of_squares, std::numeric_limits<double>::min()) / n);
+    this->criterion_values[d] = log_likelihood_term + (criterion == tCriterion::AIC ? 2 * k : k * std::log(n));
+  }
+}
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial EvaluateCrossValidation
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+void tAdaptiveDegreePolynomial<Tmax_degree>::EvaluateCrossValidation(const std::vector<tMoments> &folds, const tMoments &moments)
+{
+  double prediction_errors[Tmax_degree + 1];
+  std::fill(prediction_errors, prediction_errors + Tmax_degree + 1, 0.0);
+  size_t max_size = Tmax_degree + 1;
+  for (typename std::vector<tMoments>::const_iterator it = folds.begin(); it != folds.end(); ++it)
+  {
+    tMoments training_moments(moments);
+    training_moments -= *it;
+
+    double l[Tmax_degree + 1][Tmax_degree + 1];
+    double z[Tmax_degree + 1];
+    max_size = std::min(max_size, training_moments.DecomposeNormalEquations(l, z));
+    for (size_t size = 1; size <= max_size; ++size)
+    {
+      math::tVector < Tmax_degree + 1, double > coefficients;
+      tMoments::SolveDecomposedNormalEquations(l, z, size, coefficients);
+      prediction_errors[size - 1] += it->ResidualSumOfSquares(coefficients);
+    }
+  }
+
+  for (size_t d = 0; d < Tmax_degree + 1; ++d)
+  {
+    this->criterion_values[d] = d < max_size ? prediction_errors[d] / moments.NumberOfSamples() : std::numeric_limits<double>::infinity();
+  }
+}
+
+//----------------------------------------------------------------------
+// tAdaptiveDegreePolynomial Select
+//----------------------------------------------------------------------
+template <size_t Tmax_degree>
+const bool tAdaptiveDegreePolynomial<Tmax_degree>::Select(const tMoments &moments, size_t min_degree, double offset, double scale)
+{
+  assert(min_degree < Tmax_degree + 1);
+
+  size_t best_degree = Tmax_degree + 1;
+  for (size_t d = min_degree; d < Tmax_degree + 1; ++d)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Criterion for degree ", d, ": ", this->criterion_values[d]);
+    if (this->criterion_values[d] < std::numeric_limits<double>::infinity() &&
+        (best_degree > Tmax_degree || this->criterion_values[d] < this->criterion_values[best_degree]))
+    {
+      best_degree = d;
+    }
+  }
+  if (best_degree > Tmax_degree)
+  {
+    RRLIB_LOG_PRINT(DEBUG_WARNING, "No candidate degree could be solved.");
+    return false;
+  }
+
+  double l[Tmax_degree + 1][Tmax_degree + 1];
+  double z[Tmax_degree + 1];
+  moments.DecomposeNormalEquations(l, z);
+  math::tVector < Tmax_degree + 1, double > coefficients;
+  tMoments::SolveDecomposedNormalEquations(l, z, best_degree + 1, coefficients);
+
+  tLeastSquaresPolynomial<Tmax_degree>::ExpandNormalizedPolynomial(coefficients, offset, scale, *this);
+  this->degree = best_degree;
+
+  // the residual sum of squares does not depend on the normalization
+  size_t number_of_samples = moments.NumberOfSamples();
+  this->sigma = number_of_samples > 1 ? std::sqrt(moments.ResidualSumOfSquares(coefficients) / (number_of_samples - 1)) : 0;
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Selected degree ", this->degree, ", sigma = ", this->sigma);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,175 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tAnytimeRansac.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tAnytimeRansac
+ *
+ * \b tAnytimeRansac
+ *
+ * Runs a RANSAC model on a worker thread and publishes every improved
+ * model, so that other threads can always access the best model found
+ * so far without blocking.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tAnytimeRansac_h__
+#define __rrlib__model_fitting__tAnytimeRansac_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <atomic>
+#include <thread>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Background execution of a RANSAC model with wait-free publishing
+/*! TRansacModel is a class derived from tRansacModel (e.g.
+ *  tRansacLeastSquaresPolynomial<2>) and TModel is the base class that
+ *  holds its parameters (e.g. math::tPolynomial<2>). Every model that
+ *  DoRANSAC finds to be better than its predecessors is copied as TModel
+ *  into a triple buffer. Publishing and GetLatest are wait-free, but
+ *  there must only be one reading thread.
+ *
+ *  Start may be called again at any time (e.g. when new data arrives),
+ *  which cancels the running fit. The last published model stays
+ *  available until the new run publishes its first model.
+ */
+template <typename TRansacModel, typename TModel>
+class tAnytimeRansac
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  struct tResult
+  {
+    TModel model;
+    size_t support;
+    double error;
+    unsigned int run;
+    bool final;
+    tResult() : support(0), error(0), run(0), final(false) {}
+  };
+
+  explicit tAnytimeRansac(bool local_optimization = false);
+
+  ~tAnytimeRansac();
+
+  /*!
+   * \brief Access the worker's model to set constraints or policies
+   *
+   * Must not be used while a fit is running.
+   */
+  inline TRansacModel &Model()
+  {
+    return this->ransac_model;
+  }
+
+  /*!
+   * \brief Cancel a running fit and start a new one on the given samples
+   *
+   * The samples are copied before this method returns.
+   */
+  template <typename TIterator>
+  void Start(TIterator begin, TIterator end, unsigned int max_iterations, double satisfactory_inlier_ratio = 1.0, double max_error = 1E-6);
+
+  void Cancel();
+
+  /*!
+   * \brief Block until the running fit has finished
+   */
+  void Wait();
+
+  inline bool IsRunning() const
+  {
+    return this->running.load();
+  }
+
+  /*!
+   * \brief Get the latest published model without blocking
+   *
+   * \return Whether any model has been published so far
+   */
+  bool GetLatest(tResult &result);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cFRESH = 4, cINDEX_MASK = 3 };
+
+  TRansacModel ransac_model;
+  std::thread worker;
+  std::atomic<bool> cancelled;
+  std::atomic<bool> running;
+  unsigned int run;
+
+  tResult buffers[3];
+  std::atomic<unsigned int> middle;
+  unsigned int back;
+  unsigned int front;
+
+  tAnytimeRansac(const tAnytimeRansac &);
+  tAnytimeRansac &operator = (const tAnytimeRansac &);
+
+  void Publish(size_t support, double total_error, bool final);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tAnytimeRansac.hpp"
+
+#endif
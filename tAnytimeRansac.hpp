@@ -0,0 +1,177 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tAnytimeRansac.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tAnytimeRansac constructors
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+tAnytimeRansac<TRansacModel, TModel>::tAnytimeRansac(bool local_optimization)
+  : ransac_model(local_optimization),
+    cancelled(false),
+    running(false),
+    run(0),
+    middle(1),
+    back(2),
+    front(0)
+{
+  this->ransac_model.SetCancellationFlag(&this->cancelled);
+  this->ransac_model.SetImprovementHandler([this](size_t support, double total_error)
+  {
+    this->Publish(support, total_error, false);
+  });
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac destructor
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+tAnytimeRansac<TRansacModel, TModel>::~tAnytimeRansac()
+{
+  this->Cancel();
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac Start
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+template <typename TIterator>
+void tAnytimeRansac<TRansacModel, TModel>::Start(TIterator begin, TIterator end, unsigned int max_iterations, double satisfactory_inlier_ratio, double max_error)
+{
+  this->Cancel();
+
+  this->ransac_model.Initialize(std::distance(begin, end));
+  this->ransac_model.AddSamples(begin, end);
+  this->run++;
+
+  this->cancelled = false;
+  this->running = true;
+  this->worker = std::thread([this, max_iterations, satisfactory_inlier_ratio, max_error]()
+  {
+    if (this->ransac_model.DoRANSAC(max_iterations, satisfactory_inlier_ratio, max_error))
+    {
+      this->Publish(this->ransac_model.NumberOfInliers(), this->ransac_model.Error() * this->ransac_model.NumberOfInliers(), true);
+    }
+    this->running = false;
+  });
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac Cancel
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+void tAnytimeRansac<TRansacModel, TModel>::Cancel()
+{
+  this->cancelled = true;
+  this->Wait();
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac Wait
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+void tAnytimeRansac<TRansacModel, TModel>::Wait()
+{
+  if (this->worker.joinable())
+  {
+    this->worker.join();
+  }
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac GetLatest
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+bool tAnytimeRansac<TRansacModel, TModel>::GetLatest(tResult &result)
+{
+  if (this->middle.load() & cFRESH)
+  {
+    this->front = this->middle.exchange(this->front) & cINDEX_MASK;
+  }
+  result = this->buffers[this->front];
+  return result.run > 0;
+}
+
+//----------------------------------------------------------------------
+// tAnytimeRansac Publish
+//----------------------------------------------------------------------
+template <typename TRansacModel, typename TModel>
+void tAnytimeRansac<TRansacModel, TModel>::Publish(size_t support, double total_error, bool final)
+{
+  tResult &result = this->buffers[this->back];
+  result.model = static_cast<const TModel &>(this->ransac_model);
+  result.support = support;
+  result.error = support > 0 ? total_error / support : 0;
+  result.run = this->run;
+  result.final = final;
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Publishing model with support ", support, (final ? " (final)" : ""));
+
+  this->back = this->middle.exchange(this->back | cFRESH) & cINDEX_MASK;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
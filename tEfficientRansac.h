@@ -0,0 +1,226 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tEfficientRansac.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tEfficientRansac
+ *
+ * \b tEfficientRansac
+ *
+ * A few words for tEfficientRansac
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tEfficientRansac_h__
+#define __rrlib__model_fitting__tEfficientRansac_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <memory>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tOrientedPointShape.h"
+#include "rrlib/model_fitting/tPointOctree.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Detection of several shapes of different types in large point clouds
+/*! Implements the efficient RANSAC of Schnabel et al. for oriented
+ *  points. Shape types are registered as prototypes, e.g.
+ *  tRansacOrientedPlane3D, tRansacSphere3D, tRansacCylinder3D and
+ *  tRansacCone3D with their normal angle thresholds. Then shapes are
+ *  detected and removed one by one, largest first:
+ *
+ *  - The first sample of a minimal set is drawn uniformly, the others
+ *    from a random octree cell containing it. Levels whose candidates
+ *    scored well are preferred.
+ *  - Every minimal set is fitted with each shape type, and the
+ *    candidates are scored on a small random subset of the samples. The
+ *    estimate of their support is only refined on further subsets while
+ *    its confidence interval overlaps that of the best candidate.
+ *  - The best candidate is extracted once the probability that a larger
+ *    shape was never drawn is below the given threshold. It is refitted
+ *    to all of its inliers, which are then removed.
+ *
+ *  Detection stops when no shape of min_support samples can have been
+ *  missed with that probability either.
+ */
+template <typename TElement = double>
+class tEfficientRansac
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tOrientedPoint3D<TElement> tSample;
+  typedef tOrientedPointShape<TElement> tShape;
+
+  struct tDetectedShape
+  {
+    std::shared_ptr<const tShape> shape;
+    std::vector<size_t> sample_indices;
+  };
+
+  tEfficientRansac();
+
+  /*!
+   * \brief Register a shape type to detect, e.g. tRansacSphere3D<>(max_normal_angle_distance)
+   *
+   * The prototype is copied and does not need any samples.
+   */
+  void AddShapeType(const tShape &prototype);
+
+  /*!
+   * \brief Replace the samples and build the octree and scoring subsets
+   */
+  template <typename TIterator>
+  void SetSamples(TIterator begin, TIterator end);
+
+  /*!
+   * \brief Detect shapes in the samples, discarding previous results
+   *
+   * \param max_error              The maximal distance of inliers to their shape
+   * \param min_support            The minimal number of inliers of a shape
+   * \param max_miss_probability   The accepted probability of overlooking a larger shape
+   * \param max_draws              The maximal number of minimal sets to draw
+   *
+   * \return Whether at least one shape was detected
+   */
+  const bool Detect(double max_error, size_t min_support, double max_miss_probability = 0.01, size_t max_draws = 1000000);
+
+  inline const std::vector<tSample> &Samples() const
+  {
+    return this->samples;
+  }
+
+  /*!
+   * \brief The detected shapes in the order of their extraction
+   */
+  inline const std::vector<tDetectedShape> &DetectedShapes() const
+  {
+    return this->detected_shapes;
+  }
+
+  /*!
+   * \brief The indices of the samples that do not belong to any detected shape
+   */
+  void GetRemainingSampleIndices(std::vector<size_t> &sample_indices) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cFIRST_SUBSET_SIZE = 1000, cDRAWS_PER_ROUND = 50, cMAX_DRAW_ATTEMPTS = 20 };
+
+  struct tCandidate
+  {
+    std::shared_ptr<tShape> shape;
+    unsigned int level;
+    size_t evaluated_subsets;
+    size_t evaluated_samples;
+    size_t support;
+    double expected_support;
+    double lower_bound;
+    double upper_bound;
+  };
+
+  std::vector<std::shared_ptr<tShape>> shape_types;
+  size_t max_minimal_set_size;
+
+  std::vector<tSample> samples;
+  tPointOctree<TElement> octree;
+  std::vector<size_t> subset_order;
+  std::vector<size_t> subset_bounds;
+
+  std::vector<bool> active;
+  std::vector<size_t> active_indices;
+  std::vector<double> level_scores;
+  std::vector<double> level_draws;
+
+  std::vector<tDetectedShape> detected_shapes;
+
+  unsigned int DrawLevel() const;
+
+  const bool DrawMinimalSet(std::vector<tSample> &minimal_set, unsigned int &level) const;
+
+  /*!
+   * \brief Score the candidate on its next subset and update its confidence interval
+   */
+  void Refine(tCandidate &candidate, double max_error) const;
+
+  void Reset(tCandidate &candidate, double max_error) const;
+
+  /*!
+   * \brief The probability to draw a minimal set of a shape with the given support
+   */
+  double GetDrawProbability(double support) const;
+
+  /*!
+   * \brief Refit the candidate to all of its inliers and remove them
+   *
+   * \return Whether the shape had at least min_support inliers
+   */
+  const bool Extract(tCandidate &candidate, double max_error, size_t min_support);
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tEfficientRansac";
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tEfficientRansac.hpp"
+
+#endif
@@ -0,0 +1,437 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tEfficientRansac.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tEfficientRansac constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tEfficientRansac<TElement>::tEfficientRansac()
+  : max_minimal_set_size(0)
+{}
+
+//----------------------------------------------------------------------
+// tEfficientRansac AddShapeType
+//----------------------------------------------------------------------
+template <typename TElement>
+void tEfficientRansac<TElement>::AddShapeType(const tShape &prototype)
+{
+  this->shape_types.push_back(std::shared_ptr<tShape>(prototype.Clone()));
+  this->max_minimal_set_size = std::max(this->max_minimal_set_size, prototype.MinimalSetSize());
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac SetSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+void tEfficientRansac<TElement>::SetSamples(TIterator begin, TIterator end)
+{
+  this->samples.assign(begin, end);
+  this->detected_shapes.clear();
+
+  std::vector<typename tSample::tPoint> points;
+  points.reserve(this->samples.size());
+  for (typename std::vector<tSample>::const_iterator it = this->samples.begin(); it != this->samples.end(); ++it)
+  {
+    points.push_back(it->point);
+  }
+  this->octree.Build(points.begin(), points.end());
+
+  // disjoint random subsets of doubling size
+  this->subset_order.resize(this->samples.size());
+  for (size_t i = 0; i < this->subset_order.size(); ++i)
+  {
+    this->subset_order[i] = i;
+  }
+  for (size_t i = this->subset_order.size(); i > 1; --i)
+  {
+    std::swap(this->subset_order[i - 1], this->subset_order[rand() % i]);
+  }
+  this->subset_bounds.assign(1, 0);
+  for (size_t size = cFIRST_SUBSET_SIZE; this->subset_bounds.back() < this->samples.size(); size *= 2)
+  {
+    this->subset_bounds.push_back(std::min(this->subset_bounds.back() + size, this->samples.size()));
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Using ", this->subset_bounds.size() - 1, " subsets for scoring.");
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac Detect
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tEfficientRansac<TElement>::Detect(double max_error, size_t min_support, double max_miss_probability, size_t max_draws)
+{
+  if (this->shape_types.empty())
+  {
+    RRLIB_LOG_PRINT(ERROR, "No shape types were added!");
+    return false;
+  }
+
+  this->detected_shapes.clear();
+  this->active.assign(this->samples.size(), true);
+  this->active_indices = this->subset_order;
+  std::sort(this->active_indices.begin(), this->active_indices.end());
+  this->level_scores.assign(this->octree.Depth() + 1, 1.0);
+  this->level_draws.assign(this->octree.Depth() + 1, 1.0);
+
+  std::vector<tCandidate> candidates;
+  std::vector<tSample> minimal_set;
+  size_t number_of_draws = 0;
+  const double log_max_miss_probability = std::log(max_miss_probability);
+
+  while (this->active_indices.size() >= std::max(min_support, this->max_minimal_set_size) && number_of_draws < max_draws)
+  {
+    // draw new candidates of all shape types
+    for (size_t draw = 0; draw < cDRAWS_PER_ROUND && number_of_draws < max_draws; ++draw, ++number_of_draws)
+    {
+      unsigned int level;
+      if (!this->DrawMinimalSet(minimal_set, level))
+      {
+        continue;
+      }
+      for (typename std::vector<std::shared_ptr<tShape>>::const_iterator it = this->shape_types.begin(); it != this->shape_types.end(); ++it)
+      {
+        tCandidate candidate;
+        candidate.shape.reset((*it)->Clone());
+        candidate.level = level;
+        if (!candidate.shape->FitToMinimalSamples(minimal_set))
+        {
+          continue;
+        }
+        this->Reset(candidate, max_error);
+        this->level_scores[level] += candidate.expected_support;
+        this->level_draws[level] += 1;
+        if (candidate.upper_bound >= min_support)
+        {
+          candidates.push_back(candidate);
+        }
+      }
+    }
+
+    // refine the best candidate and all candidates that might be better until the intervals are separated
+    size_t best = 0;
+    for (bool refined = true; refined && !candidates.empty();)
+    {
+      refined = false;
+      best = 0;
+      for (size_t i = 1; i < candidates.size(); ++i)
+      {
+        if (candidates[i].expected_support > candidates[best].expected_support)
+        {
+          best = i;
+        }
+      }
+      bool overlapped = false;
+      for (size_t i = 0; i < candidates.size(); ++i)
+      {
+        if (i != best && candidates[i].upper_bound > candidates[best].lower_bound)
+        {
+          overlapped = true;
+          if (candidates[i].evaluated_subsets + 1 < this->subset_bounds.size())
+          {
+            this->Refine(candidates[i], max_error);
+            refined = true;
+          }
+        }
+      }
+      if ((overlapped || candidates[best].lower_bound < min_support) && candidates[best].evaluated_subsets + 1 < this->subset_bounds.size())
+      {
+        this->Refine(candidates[best], max_error);
+        refined = true;
+      }
+    }
+
+    // candidates that cannot reach the minimal support are never extracted
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [min_support](const tCandidate & candidate)
+    {
+      return candidate.upper_bound < min_support;
+    }), candidates.end());
+    best = 0;
+    for (size_t i = 1; i < candidates.size(); ++i)
+    {
+      if (candidates[i].expected_support > candidates[best].expected_support)
+      {
+        best = i;
+      }
+    }
+
+    if (!candidates.empty() && number_of_draws * std::log1p(-this->GetDrawProbability(candidates[best].expected_support)) < log_max_miss_probability)
+    {
+      tCandidate candidate = candidates[best];
+      candidates[best] = candidates.back();
+      candidates.pop_back();
+      if (this->Extract(candidate, max_error, min_support))
+      {
+        for (typename std::vector<tCandidate>::iterator it = candidates.begin(); it != candidates.end(); ++it)
+        {
+          this->Reset(*it, max_error);
+        }
+      }
+      continue;
+    }
+
+    if (candidates.empty() && number_of_draws * std::log1p(-this->GetDrawProbability(min_support)) < log_max_miss_probability)
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "No shape with ", min_support, " samples left after ", number_of_draws, " draws.");
+      break;
+    }
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Detected ", this->detected_shapes.size(), " shapes with ", number_of_draws, " draws. ", this->active_indices.size(), " samples remain.");
+
+  return !this->detected_shapes.empty();
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac GetRemainingSampleIndices
+//----------------------------------------------------------------------
+template <typename TElement>
+void tEfficientRansac<TElement>::GetRemainingSampleIndices(std::vector<size_t> &sample_indices) const
+{
+  sample_indices = this->active_indices;
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac DrawLevel
+//----------------------------------------------------------------------
+template <typename TElement>
+unsigned int tEfficientRansac<TElement>::DrawLevel() const
+{
+  // mix the average candidate score per level with a uniform distribution to keep exploring
+  size_t number_of_levels = this->level_scores.size();
+  std::vector<double> weights(number_of_levels);
+  double total_score = 0;
+  for (size_t i = 0; i < number_of_levels; ++i)
+  {
+    weights[i] = this->level_scores[i] / this->level_draws[i];
+    total_score += weights[i];
+  }
+  double r = static_cast<double>(rand()) / (static_cast<double>(RAND_MAX) + 1);
+  for (size_t i = 0; i < number_of_levels; ++i)
+  {
+    r -= 0.9 * weights[i] / total_score + 0.1 / number_of_levels;
+    if (r < 0)
+    {
+      return i;
+    }
+  }
+  return number_of_levels - 1;
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac DrawMinimalSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tEfficientRansac<TElement>::DrawMinimalSet(std::vector<tSample> &minimal_set, unsigned int &level) const
+{
+  minimal_set.clear();
+  size_t indices[8];
+  assert(this->max_minimal_set_size <= 8);
+
+  indices[0] = this->active_indices[rand() % this->active_indices.size()];
+  minimal_set.push_back(this->samples[indices[0]]);
+
+  const typename tPointOctree<TElement>::tNode &node = this->octree.Nodes()[this->octree.Ancestor(indices[0], this->DrawLevel())];
+  level = node.depth;
+  size_t node_size = node.end - node.begin;
+  for (size_t attempt = 0; attempt < cMAX_DRAW_ATTEMPTS * this->max_minimal_set_size && minimal_set.size() < this->max_minimal_set_size; ++attempt)
+  {
+    size_t index = this->octree.Indices()[node.begin + rand() % node_size];
+    if (this->active[index] && std::find(indices, indices + minimal_set.size(), index) == indices + minimal_set.size())
+    {
+      indices[minimal_set.size()] = index;
+      minimal_set.push_back(this->samples[index]);
+    }
+  }
+  return minimal_set.size() == this->max_minimal_set_size;
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac Reset
+//----------------------------------------------------------------------
+template <typename TElement>
+void tEfficientRansac<TElement>::Reset(tCandidate &candidate, double max_error) const
+{
+  candidate.evaluated_subsets = 0;
+  candidate.evaluated_samples = 0;
+  candidate.support = 0;
+  this->Refine(candidate, max_error);
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac Refine
+//----------------------------------------------------------------------
+template <typename TElement>
+void tEfficientRansac<TElement>::Refine(tCandidate &candidate, double max_error) const
+{
+  assert(candidate.evaluated_subsets + 1 < this->subset_bounds.size());
+  for (size_t i = this->subset_bounds[candidate.evaluated_subsets]; i < this->subset_bounds[candidate.evaluated_subsets + 1]; ++i)
+  {
+    size_t index = this->subset_order[i];
+    if (this->active[index])
+    {
+      candidate.evaluated_samples++;
+      candidate.support += candidate.shape->GetSampleError(this->samples[index]) <= max_error;
+    }
+  }
+  candidate.evaluated_subsets++;
+
+  // extrapolate the support with a confidence interval of the hypergeometric distribution
+  double n = candidate.evaluated_samples;
+  double total = this->active_indices.size();
+  if (n == 0)
+  {
+    candidate.expected_support = 0;
+    candidate.lower_bound = 0;
+    candidate.upper_bound = total;
+    return;
+  }
+  candidate.expected_support = candidate.support * total / n;
+  if (candidate.evaluated_subsets + 1 == this->subset_bounds.size())
+  {
+    candidate.lower_bound = candidate.expected_support;
+    candidate.upper_bound = candidate.expected_support;
+    return;
+  }
+  double p = (candidate.support + 1.0) / (n + 2.0);
+  double deviation = total * std::sqrt(p * (1 - p) / n * std::max(0.0, total - n) / std::max(1.0, total - 1));
+  candidate.lower_bound = candidate.expected_support - 2 * deviation;
+  candidate.upper_bound = candidate.expected_support + 2 * deviation;
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac GetDrawProbability
+//----------------------------------------------------------------------
+template <typename TElement>
+double tEfficientRansac<TElement>::GetDrawProbability(double support) const
+{
+  // the first sample hits the shape, the cell level is right and the others hit it within the cell
+  double levels = this->octree.Depth() + 1;
+  double p = support / (this->active_indices.size() * levels * (1 << (this->max_minimal_set_size - 1)));
+  return std::min(p, 1.0 - 1E-12);
+}
+
+//----------------------------------------------------------------------
+// tEfficientRansac Extract
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tEfficientRansac<TElement>::Extract(tCandidate &candidate, double max_error, size_t min_support)
+{
+  tDetectedShape detected_shape;
+  std::vector<tSample> inliers;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    detected_shape.sample_indices.clear();
+    inliers.clear();
+    for (std::vector<size_t>::const_iterator it = this->active_indices.begin(); it != this->active_indices.end(); ++it)
+    {
+      if (candidate.shape->GetSampleError(this->samples[*it]) <= max_error)
+      {
+        detected_shape.sample_indices.push_back(*it);
+        inliers.push_back(this->samples[*it]);
+      }
+    }
+    if (pass == 0 && (inliers.size() < min_support || !candidate.shape->FitToSamples(inliers)))
+    {
+      break;
+    }
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Candidate with estimated support ", candidate.expected_support, " has ", detected_shape.sample_indices.size(), " inliers.");
+  if (detected_shape.sample_indices.size() < min_support)
+  {
+    return false;
+  }
+
+  for (std::vector<size_t>::const_iterator it = detected_shape.sample_indices.begin(); it != detected_shape.sample_indices.end(); ++it)
+  {
+    this->active[*it] = false;
+  }
+  size_t number_of_active_samples = 0;
+  for (std::vector<size_t>::const_iterator it = this->active_indices.begin(); it != this->active_indices.end(); ++it)
+  {
+    if (this->active[*it])
+    {
+      this->active_indices[number_of_active_samples++] = *it;
+    }
+  }
+  this->active_indices.resize(number_of_active_samples);
+
+  detected_shape.shape = candidate.shape;
+  this->detected_shapes.push_back(detected_shape);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
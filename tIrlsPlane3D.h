@@ -0,0 +1,188 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIrlsPlane3D.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tIrlsPlane3D
+ *
+ * \b tIrlsPlane3D
+ *
+ * Iteratively reweighted PCA plane fitting with Huber, Tukey or Cauchy
+ * loss and MAD scale estimation.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tIrlsPlane3D_h__
+#define __rrlib__model_fitting__tIrlsPlane3D_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/geometry/tPlane.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/robust_loss.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Robust plane fitting by iteratively reweighted PCA
+/*! Alternates between computing point-to-plane distances, estimating
+ *  their scale by the median absolute deviation, and fitting the plane
+ *  to the weighted centre of gravity and the weakest principal component
+ *  of the weighted covariance. It can be started from an unweighted PCA
+ *  or from a plane found by tRansacPlane3D. The final weights can be used
+ *  as soft inlier assignments.
+ */
+template <typename TElement = double>
+class tIrlsPlane3D : public geometry::tPlane<3, TElement>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename geometry::tPlane<3, TElement>::tPoint tSample;
+
+  explicit tIrlsPlane3D(tRobustLoss loss = tRobustLoss::HUBER, unsigned int max_iterations = 20, double convergence_threshold = 1E-3);
+
+  template <typename TIterator>
+  tIrlsPlane3D(TIterator begin, TIterator end,
+               tRobustLoss loss = tRobustLoss::HUBER, unsigned int max_iterations = 20, double convergence_threshold = 1E-3);
+
+  inline void SetLoss(tRobustLoss loss)
+  {
+    this->loss = loss;
+  }
+
+  inline void SetMaxIterations(unsigned int max_iterations)
+  {
+    this->max_iterations = max_iterations;
+  }
+
+  /*!
+   * \brief Stop iterating when no weight changes by more than this threshold
+   */
+  inline void SetConvergenceThreshold(double convergence_threshold)
+  {
+    this->convergence_threshold = convergence_threshold;
+  }
+
+  /*!
+   * \brief Fit starting from the unweighted PCA of all samples
+   *
+   * \return Whether all weighted fits were well-defined
+   */
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end);
+
+  /*!
+   * \brief Fit starting from a given plane, e.g. a tRansacPlane3D
+   *
+   * The orientation of the initial normal is kept.
+   *
+   * \return Whether all weighted fits were well-defined
+   */
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end, const geometry::tPlane<3, TElement> &initial_model);
+
+  /*!
+   * \brief The weights of the samples for the residuals of the fitted model, in the order they were given
+   */
+  inline const std::vector<double> &Weights() const
+  {
+    return this->weights;
+  }
+
+  /*!
+   * \brief The robust estimate of the standard deviation of the distances to the fitted plane
+   */
+  inline double Scale() const
+  {
+    return this->scale;
+  }
+
+  inline unsigned int NumberOfIterations() const
+  {
+    return this->number_of_iterations;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tRobustLoss loss;
+  unsigned int max_iterations;
+  double convergence_threshold;
+
+  std::vector<double> weights;
+  std::vector<double> residuals;
+  double scale;
+  unsigned int number_of_iterations;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tIrlsPlane3D";
+  }
+
+  template <typename TIterator>
+  const bool FitWeighted(TIterator begin, TIterator end);
+
+  template <typename TIterator>
+  const bool Iterate(TIterator begin, TIterator end);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tIrlsPlane3D.hpp"
+
+#endif
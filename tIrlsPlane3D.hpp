@@ -0,0 +1,198 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIrlsPlane3D.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPlaneMoments.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tIrlsPlane3D constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tIrlsPlane3D<TElement>::tIrlsPlane3D(tRobustLoss loss, unsigned int max_iterations, double convergence_threshold)
+  : loss(loss),
+    max_iterations(max_iterations),
+    convergence_threshold(convergence_threshold),
+    scale(0),
+    number_of_iterations(0)
+{}
+
+template <typename TElement>
+template <typename TIterator>
+tIrlsPlane3D<TElement>::tIrlsPlane3D(TIterator begin, TIterator end, tRobustLoss loss, unsigned int max_iterations, double convergence_threshold)
+  : loss(loss),
+    max_iterations(max_iterations),
+    convergence_threshold(convergence_threshold),
+    scale(0),
+    number_of_iterations(0)
+{
+  if (!this->UpdateModelFromSampleSet(begin, end))
+  {
+    throw std::runtime_error("Failed to fit IRLS model during construction!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tIrlsPlane3D UpdateModelFromSampleSet
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+const bool tIrlsPlane3D<TElement>::UpdateModelFromSampleSet(TIterator begin, TIterator end)
+{
+  this->weights.assign(std::distance(begin, end), 1.0);
+  if (!this->FitWeighted(begin, end))
+  {
+    return false;
+  }
+  return this->Iterate(begin, end);
+}
+
+template <typename TElement>
+template <typename TIterator>
+const bool tIrlsPlane3D<TElement>::UpdateModelFromSampleSet(TIterator begin, TIterator end, const geometry::tPlane<3, TElement> &initial_model)
+{
+  this->Set(initial_model.Support(), initial_model.Normal());
+  this->weights.assign(std::distance(begin, end), 1.0);
+  return this->Iterate(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tIrlsPlane3D FitWeighted
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+const bool tIrlsPlane3D<TElement>::FitWeighted(TIterator begin, TIterator end)
+{
+  // perform weighted PCA
+  tPlaneMoments<TElement> moments;
+  std::vector<double>::const_iterator weight = this->weights.begin();
+  for (TIterator it = begin; it != end; ++it, ++weight)
+  {
+    moments.Add(*it, *weight);
+  }
+
+  // keep the orientation of the previous normal
+  if (!moments.GetPlane(*this))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Weighted samples do not determine a plane!");
+    return false;
+  }
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->Support(), ", ", this->Normal(), ")");
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tIrlsPlane3D Iterate
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+const bool tIrlsPlane3D<TElement>::Iterate(TIterator begin, TIterator end)
+{
+  size_t number_of_samples = this->weights.size();
+  this->residuals.resize(number_of_samples);
+
+  // the last pass only updates residuals, scale and weights, so that they belong to the final model
+  for (this->number_of_iterations = 0; ; ++this->number_of_iterations)
+  {
+    std::vector<double>::iterator residual = this->residuals.begin();
+    for (TIterator it = begin; it != end; ++it, ++residual)
+    {
+      *residual = this->GetDistanceToPoint(*it);
+    }
+    this->scale = GetMedianAbsoluteDeviationScale(this->residuals);
+
+    double max_weight_change = 0;
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      double weight = GetRobustWeight(this->loss, this->residuals[i], this->scale);
+      max_weight_change = std::max(max_weight_change, std::fabs(weight - this->weights[i]));
+      this->weights[i] = weight;
+    }
+
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Iteration ", this->number_of_iterations, ": scale = ", this->scale, ", max weight change = ", max_weight_change);
+
+    if (this->number_of_iterations == this->max_iterations || (this->number_of_iterations > 0 && max_weight_change < this->convergence_threshold))
+    {
+      break;
+    }
+
+    if (!this->FitWeighted(begin, end))
+    {
+      return false;
+    }
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Finished after ", this->number_of_iterations, " iterations with scale ", this->scale);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,186 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIrlsPolynomial.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tIrlsPolynomial
+ *
+ * \b tIrlsPolynomial
+ *
+ * Iteratively reweighted least squares for polynomials with Huber,
+ * Tukey or Cauchy loss and MAD scale estimation.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tIrlsPolynomial_h__
+#define __rrlib__model_fitting__tIrlsPolynomial_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tPolynomial.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+#include "rrlib/model_fitting/robust_loss.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Robust polynomial fitting by iteratively reweighted least squares
+/*! Alternates between computing residuals, estimating their scale by the
+ *  median absolute deviation, and solving the weighted normal equations
+ *  with weights from a robust loss function. At moderate outlier ratios
+ *  this converges in a few solves. It can be started from ordinary least
+ *  squares or from a RANSAC result, which is recommended for the
+ *  redescending Tukey and Cauchy losses when there are many outliers.
+ *  The final weights can be used as soft inlier assignments.
+ */
+template <size_t Tdegree>
+class tIrlsPolynomial : public tLeastSquaresPolynomial<Tdegree>
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename tLeastSquaresPolynomial<Tdegree>::tSample tSample;
+  typedef typename tLeastSquaresPolynomial<Tdegree>::tMoments tMoments;
+
+  explicit tIrlsPolynomial(tRobustLoss loss = tRobustLoss::HUBER, unsigned int max_iterations = 20, double convergence_threshold = 1E-3);
+
+  template <typename TIterator>
+  tIrlsPolynomial(TIterator begin, TIterator end,
+                  tRobustLoss loss = tRobustLoss::HUBER, unsigned int max_iterations = 20, double convergence_threshold = 1E-3);
+
+  inline void SetLoss(tRobustLoss loss)
+  {
+    this->loss = loss;
+  }
+
+  inline void SetMaxIterations(unsigned int max_iterations)
+  {
+    this->max_iterations = max_iterations;
+  }
+
+  /*!
+   * \brief Stop iterating when no weight changes by more than this threshold
+   */
+  inline void SetConvergenceThreshold(double convergence_threshold)
+  {
+    this->convergence_threshold = convergence_threshold;
+  }
+
+  /*!
+   * \brief Fit starting from the ordinary least squares solution
+   *
+   * \return Whether all weighted normal equations could be solved
+   */
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end);
+
+  /*!
+   * \brief Fit starting from a given model, e.g. a tRansacLeastSquaresPolynomial
+   *
+   * \return Whether all weighted normal equations could be solved
+   */
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end, const math::tPolynomial<Tdegree> &initial_model);
+
+  /*!
+   * \brief The weights of the samples for the residuals of the fitted model, in the order they were given
+   */
+  inline const std::vector<double> &Weights() const
+  {
+    return this->weights;
+  }
+
+  /*!
+   * \brief The robust estimate of the residual standard deviation of the fitted model
+   */
+  inline double Scale() const
+  {
+    return this->scale;
+  }
+
+  inline unsigned int NumberOfIterations() const
+  {
+    return this->number_of_iterations;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tRobustLoss loss;
+  unsigned int max_iterations;
+  double convergence_threshold;
+
+  std::vector<double> weights;
+  std::vector<double> residuals;
+  double scale;
+  unsigned int number_of_iterations;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tIrlsPolynomial";
+  }
+
+  template <typename TIterator>
+  const bool Iterate(TIterator begin, TIterator end);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tIrlsPolynomial.hpp"
+
+#endif
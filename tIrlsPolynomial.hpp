@@ -0,0 +1,192 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tIrlsPolynomial.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tIrlsPolynomial constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tIrlsPolynomial<Tdegree>::tIrlsPolynomial(tRobustLoss loss, unsigned int max_iterations, double convergence_threshold)
+  : loss(loss),
+    max_iterations(max_iterations),
+    convergence_threshold(convergence_threshold),
+    scale(0),
+    number_of_iterations(0)
+{}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tIrlsPolynomial<Tdegree>::tIrlsPolynomial(TIterator begin, TIterator end, tRobustLoss loss, unsigned int max_iterations, double convergence_threshold)
+  : loss(loss),
+    max_iterations(max_iterations),
+    convergence_threshold(convergence_threshold),
+    scale(0),
+    number_of_iterations(0)
+{
+  if (!this->UpdateModelFromSampleSet(begin, end))
+  {
+    throw std::runtime_error("Failed to fit IRLS model during construction!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tIrlsPolynomial UpdateModelFromSampleSet
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+const bool tIrlsPolynomial<Tdegree>::UpdateModelFromSampleSet(TIterator begin, TIterator end)
+{
+  double x_offset;
+  double x_scale;
+  this->GetNormalization(begin, end, x_offset, x_scale);
+
+  tMoments moments;
+  for (TIterator it = begin; it != end; ++it)
+  {
+    moments.Add(tSample((it->X() - x_offset) / x_scale, it->Y()));
+  }
+  if (!this->SolveNormalEquations(moments, x_offset, x_scale))
+  {
+    return false;
+  }
+  return this->Iterate(begin, end);
+}
+
+template <size_t Tdegree>
+template <typename TIterator>
+const bool tIrlsPolynomial<Tdegree>::UpdateModelFromSampleSet(TIterator begin, TIterator end, const math::tPolynomial<Tdegree> &initial_model)
+{
+  for (size_t i = 0; i < Tdegree + 1; ++i)
+  {
+    this->SetCoefficient(i, initial_model.GetCoefficient(i));
+  }
+  return this->Iterate(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tIrlsPolynomial Iterate
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+const bool tIrlsPolynomial<Tdegree>::Iterate(TIterator begin, TIterator end)
+{
+  size_t number_of_samples = std::distance(begin, end);
+  this->weights.assign(number_of_samples, 1.0);
+  this->residuals.resize(number_of_samples);
+
+  double x_offset;
+  double x_scale;
+  this->GetNormalization(begin, end, x_offset, x_scale);
+
+  // the last pass only updates residuals, scale and weights, so that they belong to the final model
+  for (this->number_of_iterations = 0; ; ++this->number_of_iterations)
+  {
+    std::vector<double>::iterator residual = this->residuals.begin();
+    for (TIterator it = begin; it != end; ++it, ++residual)
+    {
+      *residual = it->Y() - (*this)(it->X());
+    }
+    this->scale = GetMedianAbsoluteDeviationScale(this->residuals);
+
+    double max_weight_change = 0;
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      double weight = GetRobustWeight(this->loss, this->residuals[i], this->scale);
+      max_weight_change = std::max(max_weight_change, std::fabs(weight - this->weights[i]));
+      this->weights[i] = weight;
+    }
+
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Iteration ", this->number_of_iterations, ": scale = ", this->scale, ", max weight change = ", max_weight_change);
+
+    if (this->number_of_iterations == this->max_iterations || (this->number_of_iterations > 0 && max_weight_change < this->convergence_threshold))
+    {
+      break;
+    }
+
+    tMoments moments;
+    std::vector<double>::const_iterator weight = this->weights.begin();
+    for (TIterator it = begin; it != end; ++it, ++weight)
+    {
+      moments.Add(tSample((it->X() - x_offset) / x_scale, it->Y()), *weight);
+    }
+    if (!this->SolveNormalEquations(moments, x_offset, x_scale))
+    {
+      return false;
+    }
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Finished after ", this->number_of_iterations, " iterations with scale ", this->scale);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -47,6 +47,7 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPolynomialMoments.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -81,6 +82,7 @@ class tLeastSquaresPolynomial : public math::tPolynomial<Tdegree>
 public:
 
   typedef math::tVec2d tSample;
+  typedef model_fitting::tPolynomialMoments<Tdegree> tMoments;
 
   tLeastSquaresPolynomial();
 
@@ -97,6 +99,44 @@ public:
   template <typename TIterator>
   void UpdateModelFromSampleSet(TIterator begin, TIterator end);
 
+  /*!
+   * \brief Fit to the sample set whose power sums are given, independent of its size
+   */
+  void UpdateModelFromMoments(const tMoments &moments);
+
+  /*!
+   * \brief Solve the normal equations given by the power sums without throwing
+   *
+   * Uses a Cholesky decomposition on stack storage. If the power sums are
+   * those of normalized values t = (x - offset) / scale, the solution is
+   * converted back to coefficients of x.
+   *
+   * \return Whether the normal matrix was positive definite
+   */
+  const bool SolveNormalEquations(const tMoments &moments, double offset = 0, double scale = 1);
+
+  /*!
+   * \brief Determine offset and scale that map the x values of the samples to [-1, 1]
+   *
+   * Power sums of normalized x values keep the normal matrix well
+   * conditioned for x values far from zero and for higher degrees.
+   */
+  template <typename TIterator>
+  static void GetNormalization(TIterator begin, TIterator end, double &offset, double &scale);
+
+  /*!
+   * \brief Determine offset and scale that map [x_min, x_max] to [-1, 1]
+   */
+  static void GetIntervalNormalization(double x_min, double x_max, double &offset, double &scale);
+
+  /*!
+   * \brief Set polynomial to p(x) = q((x - offset) / scale), given the coefficients of q
+   *
+   * Expands the solution of normalized normal equations with Horner's scheme.
+   */
+  static void ExpandNormalizedPolynomial(const math::tVector < Tdegree + 1, double > &normalized_coefficients, double offset, double scale,
+                                         math::tPolynomial<Tdegree> &polynomial);
+
 //----------------------------------------------------------------------
 // Protected methods
 //----------------------------------------------------------------------
@@ -105,6 +145,15 @@ protected:
   template <typename TIterator>
   void DoLinearRegression(TIterator begin, TIterator end);
 
+  void DoLinearRegression(const tMoments &moments);
+
+  /*!
+   * \brief Interpolate Tdegree + 1 samples exactly using Newton's divided differences
+   *
+   * \return Whether the x values were distinct
+   */
+  const bool Interpolate(const double(&x)[Tdegree + 1], const double(&y)[Tdegree + 1]);
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -31,9 +31,11 @@
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
-#include "rrlib/math/tMatrix.h"
-#include "rrlib/math/tLUDecomposition.h"
-#include "rrlib/math/tCholeskyDecomposition.h"
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "rrlib/math/utilities.h"
 
 #include "rrlib/logging/messages.h"
 
@@ -92,12 +94,108 @@ void tLeastSquaresPolynomial<Tdegree>::UpdateModelFromSampleSet(TIterator begin,
   this->DoLinearRegression(begin, end);
 }
 
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial UpdateModelFromMoments
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomial<Tdegree>::UpdateModelFromMoments(const tMoments &moments)
+{
+  this->DoLinearRegression(moments);
+}
+
 //----------------------------------------------------------------------
 // tLeastSquaresPolynomial DoLinearRegression
 //----------------------------------------------------------------------
 template <size_t Tdegree>
 template <typename TIterator>
 void tLeastSquaresPolynomial<Tdegree>::DoLinearRegression(TIterator begin, TIterator end)
+{
+  double offset;
+  double scale;
+  GetNormalization(begin, end, offset, scale);
+
+  tMoments moments;
+  for (TIterator it = begin; it != end; ++it)
+  {
+    moments.Add(math::tVec2d((it->X() - offset) / scale, it->Y()));
+  }
+  if (!this->SolveNormalEquations(moments, offset, scale))
+  {
+    throw std::logic_error("Normal matrix of least squares polynomial is not positive definite!");
+  }
+}
+
+template <size_t Tdegree>
+void tLeastSquaresPolynomial<Tdegree>::DoLinearRegression(const tMoments &moments)
+{
+  if (!this->SolveNormalEquations(moments))
+  {
+    throw std::logic_error("Normal matrix of least squares polynomial is not positive definite!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial GetNormalization
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tLeastSquaresPolynomial<Tdegree>::GetNormalization(TIterator begin, TIterator end, double &offset, double &scale)
+{
+  offset = 0;
+  scale = 1;
+  if (begin == end)
+  {
+    return;
+  }
+  double min = begin->X();
+  double max = begin->X();
+  for (TIterator it = begin; it != end; ++it)
+  {
+    min = std::min<double>(min, it->X());
+    max = std::max<double>(max, it->X());
+  }
+  GetIntervalNormalization(min, max, offset, scale);
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial GetIntervalNormalization
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomial<Tdegree>::GetIntervalNormalization(double x_min, double x_max, double &offset, double &scale)
+{
+  offset = 0.5 * (x_min + x_max);
+  scale = x_max > x_min ? 0.5 * (x_max - x_min) : 1.0;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial ExpandNormalizedPolynomial
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomial<Tdegree>::ExpandNormalizedPolynomial(const math::tVector < Tdegree + 1, double > &normalized_coefficients, double offset, double scale,
+    math::tPolynomial<Tdegree> &polynomial)
+{
+  // expand q(t) = q((x - offset) / scale) with Horner's scheme
+  double coefficients[Tdegree + 1] = {};
+  for (size_t k = Tdegree + 1; k-- > 0;)
+  {
+    for (size_t j = Tdegree; j > 0; --j)
+    {
+      coefficients[j] = (coefficients[j - 1] - offset * coefficients[j]) / scale;
+    }
+    coefficients[0] = normalized_coefficients[k] - offset * coefficients[0] / scale;
+  }
+
+  for (size_t i = 0; i < Tdegree + 1; ++i)
+  {
+    polynomial.SetCoefficient(i, coefficients[i]);
+  }
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial SolveNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tLeastSquaresPolynomial<Tdegree>::SolveNormalEquations(const tMoments &moments, double offset, double scale)
 {
   /*
    * After some derivation work doing linear regression in this case means solving
@@ -108,53 +206,73 @@ void tLeastSquaresPolynomial<Tdegree>::DoLinearRegression(TIterator begin, TIter
    * S(xi^n*xi^0)   ...   S(xi^n*xi^n)   |   S(xi^n*yi)
    *
    */
-  math::tMatrix < Tdegree + 1, Tdegree + 1, double > A;
-  math::tVector < Tdegree + 1, double > b;
-
-  for (TIterator it = begin; it != end; ++it)
+  double l[Tdegree + 1][Tdegree + 1];
+  double z[Tdegree + 1];
+  if (moments.DecomposeNormalEquations(l, z) < Tdegree + 1)
   {
-    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Considering sample ", *it);
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Normal matrix is not positive definite.");
+    return false;
+  }
 
-    double coefficient_components[2 * Tdegree + 1];
-    coefficient_components[0] = 1;
-    for (size_t i = 1; i < 2 * Tdegree + 1; ++i)
-    {
-      coefficient_components[i] = it->X() * coefficient_components[i - 1];
-    }
+  math::tVector < Tdegree + 1, double > solution;
+  tMoments::SolveDecomposedNormalEquations(l, z, Tdegree + 1, solution);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "x = ", solution);
 
-    for (size_t row = 0; row < Tdegree + 1; ++row)
+  ExpandNormalizedPolynomial(solution, offset, scale, *this);
+
+  // calculate standard deviation from the power sums, which does not depend on the normalization
+  size_t number_of_samples = moments.NumberOfSamples();
+  this->sigma = number_of_samples > 1 ? std::sqrt(moments.ResidualSumOfSquares(solution) / (number_of_samples - 1)) : 0;
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "sigma = ", this->sigma);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomial Interpolate
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tLeastSquaresPolynomial<Tdegree>::Interpolate(const double(&x)[Tdegree + 1], const double(&y)[Tdegree + 1])
+{
+  // divided differences: c[i] = y[x0, ..., xi]
+  double c[Tdegree + 1];
+  std::copy(y, y + Tdegree + 1, c);
+  for (size_t j = 1; j < Tdegree + 1; ++j)
+  {
+    for (size_t i = Tdegree; i >= j; --i)
     {
-      for (size_t column = 0; column <= row; ++column)
+      double dx = x[i] - x[i - j];
+      if (math::IsEqual(dx, 0.0))
       {
-        A[row][column] += coefficient_components[row + column];
+        RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples with equal x values cannot be interpolated.");
+        return false;
       }
-      b[row] += coefficient_components[row] * it->Y();
+      c[i] = (c[i] - c[i - 1]) / dx;
     }
   }
 
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Solving ", A, " x = ", b);
-
-  math::tCholeskyDecomposition < Tdegree + 1 > cholesky_decomposition(A);
-  math::tVector < Tdegree + 1 > solution = cholesky_decomposition.Solve(b);
-
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "x = ", solution);
-
-  for (size_t i = 0; i < Tdegree + 1; ++i)
+  // expand c0 + (x - x0) * (c1 + (x - x1) * (c2 + ...)) into monomial coefficients
+  double coefficients[Tdegree + 1];
+  std::fill(coefficients, coefficients + Tdegree + 1, 0.0);
+  coefficients[0] = c[Tdegree];
+  for (size_t k = Tdegree; k-- > 0;)
   {
-    this->SetCoefficient(i, solution[i]);
+    for (size_t i = Tdegree - k; i > 0; --i)
+    {
+      coefficients[i] = coefficients[i - 1] - x[k] * coefficients[i];
+    }
+    coefficients[0] = c[k] - x[k] * coefficients[0];
   }
 
-  // calculate standard deviation
-  size_t number_of_samples = 0;
-  for (TIterator it = begin; it != end; ++it)
+  for (size_t i = 0; i < Tdegree + 1; ++i)
   {
-    double error = it->Y() - (*this)(it->X());
-    this->sigma += error * error;
-    number_of_samples++;
+    this->SetCoefficient(i, coefficients[i]);
   }
-  this->sigma = std::sqrt(this->sigma / (number_of_samples - 1));
+  this->sigma = 0;
 
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "sigma = ", this->sigma);
+  return true;
 }
 
 //----------------------------------------------------------------------
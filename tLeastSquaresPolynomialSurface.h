@@ -0,0 +1,191 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tLeastSquaresPolynomialSurface.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tLeastSquaresPolynomialSurface
+ *
+ * \b tLeastSquaresPolynomialSurface
+ *
+ * Least squares fitting of bivariate polynomial surfaces z = f(x, y)
+ * such as local height maps.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tLeastSquaresPolynomialSurface_h__
+#define __rrlib__model_fitting__tLeastSquaresPolynomialSurface_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPolynomialSurfaceMoments.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Least squares bivariate polynomial surface z = f(x, y)
+/*! Fits all monomials x^a*y^b with a + b <= Tdegree, e.g. a local height
+ *  map of terrain. Like tLeastSquaresPolynomial, x and y are normalized
+ *  to [-1, 1] before the normal equations are built and the solution is
+ *  converted back, so that patches far from the map origin stay well
+ *  conditioned. The coefficients are stored in the graded order of
+ *  tPolynomialSurfaceMoments.
+ */
+template <size_t Tdegree>
+class tLeastSquaresPolynomialSurface
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVec3d tSample;
+  typedef model_fitting::tPolynomialSurfaceMoments<Tdegree> tMoments;
+
+  enum { cNUMBER_OF_COEFFICIENTS = tMoments::cNUMBER_OF_TERMS };
+
+  tLeastSquaresPolynomialSurface();
+
+  template <typename TIterator>
+  tLeastSquaresPolynomialSurface(TIterator begin, TIterator end);
+
+  virtual ~tLeastSquaresPolynomialSurface()
+  {}
+
+  inline double GetStandardDeviation() const
+  {
+    return this->sigma;
+  }
+
+  /*!
+   * \brief The coefficient of x^x_exponent * y^y_exponent
+   */
+  double GetCoefficient(size_t x_exponent, size_t y_exponent) const;
+
+  void SetCoefficient(size_t x_exponent, size_t y_exponent, double value);
+
+  /*!
+   * \brief All coefficients in graded order 1, x, y, x^2, x*y, y^2, ...
+   */
+  inline const double(&Coefficients() const)[cNUMBER_OF_COEFFICIENTS]
+  {
+    return this->coefficients;
+  }
+
+  double operator()(double x, double y) const;
+
+  template <typename TIterator>
+  void UpdateModelFromSampleSet(TIterator begin, TIterator end);
+
+  /*!
+   * \brief Fit to the sample set whose power sums are given, independent of its size
+   */
+  void UpdateModelFromMoments(const tMoments &moments);
+
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * \brief Determine offsets and scales that map the x and y values of the samples to [-1, 1]
+   */
+  template <typename TIterator>
+  static void GetNormalization(TIterator begin, TIterator end, double &x_offset, double &x_scale, double &y_offset, double &y_scale);
+
+  /*!
+   * \brief Solve the normal equations given by the power sums without throwing
+   *
+   * If the power sums are those of normalized values, the solution is
+   * converted back to coefficients of x and y.
+   *
+   * \return Whether the normal matrix was positive definite
+   */
+  const bool SolveNormalEquations(const tMoments &moments, double x_offset = 0, double x_scale = 1, double y_offset = 0, double y_scale = 1);
+
+  /*!
+   * \brief Interpolate cNUMBER_OF_COEFFICIENTS samples exactly
+   *
+   * Uses Gaussian elimination with partial pivoting in normalized coordinates.
+   *
+   * \return Whether the samples determine a unique surface
+   */
+  const bool Interpolate(const double(&x)[cNUMBER_OF_COEFFICIENTS], const double(&y)[cNUMBER_OF_COEFFICIENTS], const double(&z)[cNUMBER_OF_COEFFICIENTS]);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  double coefficients[cNUMBER_OF_COEFFICIENTS];
+  double sigma;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tLeastSquaresPolynomialSurface";
+  }
+
+  static size_t GetTerm(size_t x_exponent, size_t y_exponent);
+
+  /*!
+   * \brief Replace coefficients of normalized values by those of x and y
+   */
+  void Denormalize(const double(&normalized_coefficients)[cNUMBER_OF_COEFFICIENTS], double x_offset, double x_scale, double y_offset, double y_scale);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tLeastSquaresPolynomialSurface.hpp"
+
+#endif
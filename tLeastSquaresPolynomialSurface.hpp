@@ -0,0 +1,382 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tLeastSquaresPolynomialSurface.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+
+#include "rrlib/util/join.h"
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tLeastSquaresPolynomialSurface<Tdegree>::tLeastSquaresPolynomialSurface()
+  : sigma(0)
+{
+  std::fill(this->coefficients, this->coefficients + cNUMBER_OF_COEFFICIENTS, 0.0);
+}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tLeastSquaresPolynomialSurface<Tdegree>::tLeastSquaresPolynomialSurface(TIterator begin, TIterator end)
+  : sigma(0)
+{
+  std::fill(this->coefficients, this->coefficients + cNUMBER_OF_COEFFICIENTS, 0.0);
+  this->UpdateModelFromSampleSet(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface GetTerm
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+size_t tLeastSquaresPolynomialSurface<Tdegree>::GetTerm(size_t x_exponent, size_t y_exponent)
+{
+  size_t total_degree = x_exponent + y_exponent;
+  assert(total_degree <= Tdegree);
+  return total_degree * (total_degree + 1) / 2 + y_exponent;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface GetCoefficient
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tLeastSquaresPolynomialSurface<Tdegree>::GetCoefficient(size_t x_exponent, size_t y_exponent) const
+{
+  return this->coefficients[GetTerm(x_exponent, y_exponent)];
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface SetCoefficient
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomialSurface<Tdegree>::SetCoefficient(size_t x_exponent, size_t y_exponent, double value)
+{
+  this->coefficients[GetTerm(x_exponent, y_exponent)] = value;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface operator ()
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tLeastSquaresPolynomialSurface<Tdegree>::operator()(double x, double y) const
+{
+  double x_powers[Tdegree + 1];
+  double y_powers[Tdegree + 1];
+  x_powers[0] = 1;
+  y_powers[0] = 1;
+  for (size_t k = 1; k < Tdegree + 1; ++k)
+  {
+    x_powers[k] = x_powers[k - 1] * x;
+    y_powers[k] = y_powers[k - 1] * y;
+  }
+
+  double value = 0;
+  size_t term = 0;
+  for (size_t total_degree = 0; total_degree < Tdegree + 1; ++total_degree)
+  {
+    for (size_t y_exponent = 0; y_exponent <= total_degree; ++y_exponent, ++term)
+    {
+      value += this->coefficients[term] * x_powers[total_degree - y_exponent] * y_powers[y_exponent];
+    }
+  }
+  return value;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface UpdateModelFromSampleSet
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tLeastSquaresPolynomialSurface<Tdegree>::UpdateModelFromSampleSet(TIterator begin, TIterator end)
+{
+  double x_offset, x_scale, y_offset, y_scale;
+  GetNormalization(begin, end, x_offset, x_scale, y_offset, y_scale);
+
+  tMoments moments;
+  for (TIterator it = begin; it != end; ++it)
+  {
+    moments.Add(tSample((it->X() - x_offset) / x_scale, (it->Y() - y_offset) / y_scale, it->Z()));
+  }
+  if (!this->SolveNormalEquations(moments, x_offset, x_scale, y_offset, y_scale))
+  {
+    throw std::logic_error("Normal matrix of least squares polynomial surface is not positive definite!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface UpdateModelFromMoments
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomialSurface<Tdegree>::UpdateModelFromMoments(const tMoments &moments)
+{
+  if (!this->SolveNormalEquations(moments))
+  {
+    throw std::logic_error("Normal matrix of least squares polynomial surface is not positive definite!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface GetNormalization
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tLeastSquaresPolynomialSurface<Tdegree>::GetNormalization(TIterator begin, TIterator end, double &x_offset, double &x_scale, double &y_offset, double &y_scale)
+{
+  x_offset = 0;
+  x_scale = 1;
+  y_offset = 0;
+  y_scale = 1;
+  if (begin == end)
+  {
+    return;
+  }
+  double x_min = begin->X();
+  double x_max = begin->X();
+  double y_min = begin->Y();
+  double y_max = begin->Y();
+  for (TIterator it = begin; it != end; ++it)
+  {
+    x_min = std::min<double>(x_min, it->X());
+    x_max = std::max<double>(x_max, it->X());
+    y_min = std::min<double>(y_min, it->Y());
+    y_max = std::max<double>(y_max, it->Y());
+  }
+  x_offset = 0.5 * (x_min + x_max);
+  x_scale = x_max > x_min ? 0.5 * (x_max - x_min) : 1.0;
+  y_offset = 0.5 * (y_min + y_max);
+  y_scale = y_max > y_min ? 0.5 * (y_max - y_min) : 1.0;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface SolveNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tLeastSquaresPolynomialSurface<Tdegree>::SolveNormalEquations(const tMoments &moments, double x_offset, double x_scale, double y_offset, double y_scale)
+{
+  double l[cNUMBER_OF_COEFFICIENTS][cNUMBER_OF_COEFFICIENTS];
+  double z[cNUMBER_OF_COEFFICIENTS];
+  if (!moments.DecomposeNormalEquations(l, z))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Normal matrix is not positive definite.");
+    return false;
+  }
+
+  double solution[cNUMBER_OF_COEFFICIENTS];
+  tMoments::SolveDecomposedNormalEquations(l, z, solution);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "x = [ ", util::Join(solution, solution + cNUMBER_OF_COEFFICIENTS, ", "), "]");
+
+  this->Denormalize(solution, x_offset, x_scale, y_offset, y_scale);
+
+  // calculate standard deviation from the power sums, which does not depend on the normalization
+  size_t number_of_samples = moments.NumberOfSamples();
+  this->sigma = number_of_samples > 1 ? std::sqrt(moments.ResidualSumOfSquares(solution) / (number_of_samples - 1)) : 0;
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "sigma = ", this->sigma);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface Interpolate
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tLeastSquaresPolynomialSurface<Tdegree>::Interpolate(const double(&x)[cNUMBER_OF_COEFFICIENTS], const double(&y)[cNUMBER_OF_COEFFICIENTS], const double(&z)[cNUMBER_OF_COEFFICIENTS])
+{
+  const size_t n = cNUMBER_OF_COEFFICIENTS;
+
+  double x_min = *std::min_element(x, x + n);
+  double x_max = *std::max_element(x, x + n);
+  double y_min = *std::min_element(y, y + n);
+  double y_max = *std::max_element(y, y + n);
+  double x_offset = 0.5 * (x_min + x_max);
+  double x_scale = x_max > x_min ? 0.5 * (x_max - x_min) : 1.0;
+  double y_offset = 0.5 * (y_min + y_max);
+  double y_scale = y_max > y_min ? 0.5 * (y_max - y_min) : 1.0;
+
+  // set up the system of monomials of the normalized samples
+  double a[n][n + 1];
+  for (size_t row = 0; row < n; ++row)
+  {
+    double s = (x[row] - x_offset) / x_scale;
+    double t = (y[row] - y_offset) / y_scale;
+    for (size_t term = 0; term < n; ++term)
+    {
+      size_t x_exponent, y_exponent;
+      tMoments::GetExponents(term, x_exponent, y_exponent);
+      a[row][term] = std::pow(s, static_cast<int>(x_exponent)) * std::pow(t, static_cast<int>(y_exponent));
+    }
+    a[row][n] = z[row];
+  }
+
+  for (size_t column = 0; column < n; ++column)
+  {
+    size_t pivot = column;
+    for (size_t row = column + 1; row < n; ++row)
+    {
+      if (std::fabs(a[row][column]) > std::fabs(a[pivot][column]))
+      {
+        pivot = row;
+      }
+    }
+    // entries are O(1) in normalized coordinates, so an absolute threshold detects degenerate configurations
+    if (std::fabs(a[pivot][column]) < 1E-9)
+    {
+      return false;
+    }
+    for (size_t k = column; k < n + 1; ++k)
+    {
+      std::swap(a[column][k], a[pivot][k]);
+    }
+    for (size_t row = column + 1; row < n; ++row)
+    {
+      double factor = a[row][column] / a[column][column];
+      for (size_t k = column; k < n + 1; ++k)
+      {
+        a[row][k] -= factor * a[column][k];
+      }
+    }
+  }
+
+  double solution[n];
+  for (size_t row = n; row-- > 0;)
+  {
+    double sum = a[row][n];
+    for (size_t k = row + 1; k < n; ++k)
+    {
+      sum -= a[row][k] * solution[k];
+    }
+    solution[row] = sum / a[row][row];
+  }
+
+  this->Denormalize(solution, x_offset, x_scale, y_offset, y_scale);
+  this->sigma = 0;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tLeastSquaresPolynomialSurface Denormalize
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tLeastSquaresPolynomialSurface<Tdegree>::Denormalize(const double(&normalized_coefficients)[cNUMBER_OF_COEFFICIENTS], double x_offset, double x_scale, double y_offset, double y_scale)
+{
+  double c[Tdegree + 1][Tdegree + 1] = {};
+  for (size_t term = 0; term < cNUMBER_OF_COEFFICIENTS; ++term)
+  {
+    size_t x_exponent, y_exponent;
+    tMoments::GetExponents(term, x_exponent, y_exponent);
+    c[x_exponent][y_exponent] = normalized_coefficients[term];
+  }
+
+  // substitute s = (x - x_offset) / x_scale in each column with Horner's scheme, then t = (y - y_offset) / y_scale in each row
+  for (size_t y_exponent = 0; y_exponent < Tdegree + 1; ++y_exponent)
+  {
+    size_t degree = Tdegree - y_exponent;
+    double expanded[Tdegree + 1] = {};
+    for (size_t k = degree + 1; k-- > 0;)
+    {
+      for (size_t j = degree; j > 0; --j)
+      {
+        expanded[j] = (expanded[j - 1] - x_offset * expanded[j]) / x_scale;
+      }
+      expanded[0] = c[k][y_exponent] - x_offset * expanded[0] / x_scale;
+    }
+    for (size_t k = 0; k < degree + 1; ++k)
+    {
+      c[k][y_exponent] = expanded[k];
+    }
+  }
+  for (size_t x_exponent = 0; x_exponent < Tdegree + 1; ++x_exponent)
+  {
+    size_t degree = Tdegree - x_exponent;
+    double expanded[Tdegree + 1] = {};
+    for (size_t k = degree + 1; k-- > 0;)
+    {
+      for (size_t j = degree; j > 0; --j)
+      {
+        expanded[j] = (expanded[j - 1] - y_offset * expanded[j]) / y_scale;
+      }
+      expanded[0] = c[x_exponent][k] - y_offset * expanded[0] / y_scale;
+    }
+    for (size_t k = 0; k < degree + 1; ++k)
+    {
+      c[x_exponent][k] = expanded[k];
+    }
+  }
+
+  for (size_t term = 0; term < cNUMBER_OF_COEFFICIENTS; ++term)
+  {
+    size_t x_exponent, y_exponent;
+    tMoments::GetExponents(term, x_exponent, y_exponent);
+    this->coefficients[term] = c[x_exponent][y_exponent];
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
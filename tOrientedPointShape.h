@@ -0,0 +1,142 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tOrientedPointShape.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tOrientedPointShape
+ *
+ * \b tOrientedPointShape
+ *
+ * A few words for tOrientedPointShape
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tOrientedPointShape_h__
+#define __rrlib__model_fitting__tOrientedPointShape_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/geometry/tPlane.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! A point with its surface normal, e.g. estimated from a depth image
+template <typename TElement = double>
+struct tOrientedPoint3D
+{
+  typedef typename geometry::tPlane<3, TElement>::tPoint tPoint;
+
+  tPoint point;
+  tPoint normal;
+
+  tOrientedPoint3D() {}
+
+  tOrientedPoint3D(const tPoint &point, const tPoint &normal)
+    : point(point),
+      normal(normal)
+  {}
+};
+
+//! Interface of shape models that are fitted to oriented points
+/*! Shape models like tRansacSphere3D are tRansacModels on their own. This
+ *  interface additionally lets them be fitted and scored on samples they
+ *  do not store, so that tEfficientRansac can hold many candidates of
+ *  different shape types without copying the point cloud into each one.
+ *
+ *  GetSampleError and MinimalSetSize override the methods of tRansacModel
+ *  with the same signatures.
+ */
+template <typename TElement = double>
+class tOrientedPointShape
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tOrientedPoint3D<TElement> tSample;
+
+  virtual ~tOrientedPointShape()
+  {}
+
+  /*!
+   * \brief A copy of this shape, which is owned by the caller
+   */
+  virtual tOrientedPointShape *Clone() const = 0;
+
+  virtual const size_t MinimalSetSize() const = 0;
+
+  /*!
+   * \brief Fit the shape to the first MinimalSetSize() of the given samples
+   *
+   * \return Whether the samples determine a shape that satisfies the constraints
+   */
+  virtual const bool FitToMinimalSamples(const std::vector<tSample> &samples) = 0;
+
+  /*!
+   * \brief Least squares refit to the given samples, e.g. the inliers of a detected shape
+   *
+   * \return Whether the samples determine a shape that satisfies the constraints
+   */
+  virtual const bool FitToSamples(const std::vector<tSample> &samples) = 0;
+
+  /*!
+   * \brief The distance of the sample to the shape, or infinity if its normal does not agree
+   */
+  virtual const TElement GetSampleError(const tSample &sample) const = 0;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#endif
@@ -41,6 +41,10 @@
 //----------------------------------------------------------------------
 #include <vector>
 #include <random>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <atomic>
 
 #include "rrlib/math/tMultivariateNormalDistribution.h"
 
@@ -106,6 +110,14 @@ public:
     }
   };
 
+  enum class tResamplingScheme
+  {
+    MULTINOMIAL,   //!< Independent draws from an alias table
+    SYSTEMATIC,    //!< One random offset for evenly spaced positions on the cumulative scores (lowest variance)
+    STRATIFIED,    //!< One random position in each of the evenly spaced strata of the cumulative scores
+    RESIDUAL       //!< floor(n * score) copies of each particle, the remainder drawn multinomially
+  };
+
   explicit tParticleFilter(long int seed = ::time(NULL));
 
   virtual ~tParticleFilter() = 0;
@@ -116,6 +128,13 @@ public:
   void Initialize(unsigned int number_of_particles,
                   const tConfiguration &lower_bound, const tConfiguration &upper_bound, const tConfiguration &variance, double resampling_ratio = 0.9) __attribute__((deprecated));
 
+  /*!
+   * \brief The fraction of particles that is resampled in each update
+   *
+   * The remaining particles are drawn uniformly from the bounds again, so
+   * that the filter still finds configurations far from its current
+   * particles. The number of particles stays constant.
+   */
   inline void SetResamplingRatio(double resampling_ratio)
   {
     assert(0 <= resampling_ratio && resampling_ratio <= 1);
@@ -127,13 +146,60 @@ public:
     this->multivariate_normal_distribution = tMultivariateNormalDistribution(tConfiguration::Zero(), covariance);
   }
 
+  /*!
+   * \brief Score the particles on the given number of threads
+   *
+   * CalculateConfigurationScoreImplementation must then be safe to call
+   * concurrently. Configurations are still generated from the filter's
+   * random number generator in the calling thread, so the particles do
+   * not depend on the number of threads.
+   */
+  inline void SetNumberOfThreads(unsigned int number_of_threads)
+  {
+    assert(number_of_threads > 0);
+    this->number_of_threads = number_of_threads;
+  }
+
+  /*!
+   * \brief The maximal number of configurations that are scored in one call of CalculateConfigurationScoresImplementation
+   *
+   * Batched score functions prefer a multiple of their vector width. The default is 16.
+   */
+  inline void SetScoringBatchSize(size_t scoring_batch_size)
+  {
+    assert(scoring_batch_size > 0);
+    this->scoring_batch_size = scoring_batch_size;
+  }
+
+  /*!
+   * \brief Select the scheme that draws the ancestors of resampled particles
+   *
+   * All schemes take time linear in the number of particles. The default
+   * is SYSTEMATIC.
+   */
+  inline void SetResamplingScheme(tResamplingScheme resampling_scheme)
+  {
+    this->resampling_scheme = resampling_scheme;
+  }
+
   void PerformUpdate();
 
+  /*!
+   * \brief The current particles, in no particular order
+   */
   inline const std::vector<tParticle> &Particles() const
   {
     return this->particles;
   }
 
+  /*!
+   * \brief The particles with the highest scores, best first
+   *
+   * Only the requested number of particles is sorted, e.g. 1 for the best
+   * configuration.
+   */
+  void GetRankedParticles(std::vector<tParticle> &ranked_particles, size_t max_number_of_particles = std::numeric_limits<size_t>::max()) const;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -143,6 +209,9 @@ private:
   tConfiguration lower_bound;
   tConfiguration upper_bound;
   double resampling_ratio;
+  tResamplingScheme resampling_scheme;
+  unsigned int number_of_threads;
+  size_t scoring_batch_size;
 
   mutable std::mt19937 rng_engine;
   mutable tMultivariateNormalDistribution multivariate_normal_distribution;
@@ -156,10 +225,35 @@ private:
 
   tConfiguration GenerateConfiguration(const tConfiguration &center) const;
 
-  inline double CalculateConfigurationScore(const tConfiguration &configuration) const;
+  tConfiguration GenerateUniformConfiguration() const;
+
+  /*!
+   * \brief Draw the indices of the particles that are resampled according to their normalized scores
+   */
+  void DrawAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const;
+
+  void DrawMultinomialAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const;
+
+  void DrawStratifiedAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, bool common_offset, std::vector<size_t> &ancestor_indices) const;
+
+  void DrawResidualAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const;
+
+  /*!
+   * \brief Score all configurations, distributing batches of them over the threads
+   */
+  void CalculateConfigurationScores(const std::vector<tConfiguration> &configurations, std::vector<double> &scores) const;
 
   virtual double CalculateConfigurationScoreImplementation(const tConfiguration &configuration) const = 0;
 
+  /*!
+   * \brief Score a contiguous batch of configurations at once, e.g. with a vectorized sensor model
+   *
+   * Batches hold up to the scoring batch size configurations and are
+   * scored concurrently if several threads are used. The default calls
+   * CalculateConfigurationScoreImplementation for every configuration.
+   */
+  virtual void CalculateConfigurationScoresImplementation(const tConfiguration *configurations, size_t number_of_configurations, double *scores) const;
+
 };
 
 //----------------------------------------------------------------------
@@ -70,6 +70,9 @@ namespace model_fitting
 template <typename TConfiguration>
 tParticleFilter<TConfiguration>::tParticleFilter(long int seed)
   : number_of_particles(0),
+    resampling_scheme(tResamplingScheme::SYSTEMATIC),
+    number_of_threads(1),
+    scoring_batch_size(16),
     rng_engine(seed)
 {}
 
@@ -134,14 +137,205 @@ TConfiguration tParticleFilter<TConfiguration>::GenerateConfiguration(const tCon
 }
 
 //----------------------------------------------------------------------
-// tParticleFilter CalculateConfigurationScore
+// tParticleFilter GenerateUniformConfiguration
 //----------------------------------------------------------------------
 template <typename TConfiguration>
-double tParticleFilter<TConfiguration>::CalculateConfigurationScore(const tConfiguration &configuration) const
+TConfiguration tParticleFilter<TConfiguration>::GenerateUniformConfiguration() const
 {
-  double score = this->CalculateConfigurationScoreImplementation(configuration);
-  assert(score >= 0.0);
-  return score;
+  tConfiguration configuration;
+  for (size_t k = 0; k < tConfiguration::cDIMENSION; ++k)
+  {
+    configuration[k] = std::uniform_real_distribution<typename tConfiguration::tElement>(this->lower_bound[k], this->upper_bound[k])(this->rng_engine);
+  }
+  return configuration;
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter DrawAncestorIndices
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::DrawAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const
+{
+  ancestor_indices.clear();
+  ancestor_indices.reserve(number_of_draws);
+  if (weights.empty() || number_of_draws == 0)
+  {
+    return;
+  }
+
+  switch (this->resampling_scheme)
+  {
+  case tResamplingScheme::MULTINOMIAL:
+    this->DrawMultinomialAncestorIndices(weights, number_of_draws, ancestor_indices);
+    break;
+  case tResamplingScheme::SYSTEMATIC:
+    this->DrawStratifiedAncestorIndices(weights, number_of_draws, true, ancestor_indices);
+    break;
+  case tResamplingScheme::STRATIFIED:
+    this->DrawStratifiedAncestorIndices(weights, number_of_draws, false, ancestor_indices);
+    break;
+  case tResamplingScheme::RESIDUAL:
+    this->DrawResidualAncestorIndices(weights, number_of_draws, ancestor_indices);
+    break;
+  }
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter DrawMultinomialAncestorIndices
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::DrawMultinomialAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const
+{
+  // Vose's alias method: every column of height 1 / n holds a particle and the rest of one other particle
+  const size_t n = weights.size();
+  std::vector<double> probabilities(n);
+  std::vector<size_t> aliases(n);
+  std::vector<size_t> small;
+  std::vector<size_t> large;
+  for (size_t i = 0; i < n; ++i)
+  {
+    probabilities[i] = weights[i] * n;
+    aliases[i] = i;
+    (probabilities[i] < 1.0 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty())
+  {
+    size_t s = small.back();
+    size_t l = large.back();
+    small.pop_back();
+    aliases[s] = l;
+    probabilities[l] -= 1.0 - probabilities[s];
+    if (probabilities[l] < 1.0)
+    {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // the remaining columns are full up to rounding errors
+  for (std::vector<size_t>::const_iterator it = small.begin(); it != small.end(); ++it)
+  {
+    probabilities[*it] = 1.0;
+  }
+  for (std::vector<size_t>::const_iterator it = large.begin(); it != large.end(); ++it)
+  {
+    probabilities[*it] = 1.0;
+  }
+
+  std::uniform_int_distribution<size_t> column_distribution(0, n - 1);
+  std::uniform_real_distribution<double> height_distribution(0.0, 1.0);
+  for (size_t k = 0; k < number_of_draws; ++k)
+  {
+    size_t column = column_distribution(this->rng_engine);
+    ancestor_indices.push_back(height_distribution(this->rng_engine) < probabilities[column] ? column : aliases[column]);
+  }
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter DrawStratifiedAncestorIndices
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::DrawStratifiedAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, bool common_offset, std::vector<size_t> &ancestor_indices) const
+{
+  std::uniform_real_distribution<double> offset_distribution(0.0, 1.0);
+  double offset = offset_distribution(this->rng_engine);
+
+  // positions increase with k, so one pass over the cumulative weights suffices
+  size_t i = 0;
+  double cumulative_weight = weights[0];
+  for (size_t k = 0; k < number_of_draws; ++k)
+  {
+    if (!common_offset && k > 0)
+    {
+      offset = offset_distribution(this->rng_engine);
+    }
+    double position = (k + offset) / number_of_draws;
+    while (position >= cumulative_weight && i + 1 < weights.size())
+    {
+      ++i;
+      cumulative_weight += weights[i];
+    }
+    ancestor_indices.push_back(i);
+  }
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter DrawResidualAncestorIndices
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::DrawResidualAncestorIndices(const std::vector<double> &weights, size_t number_of_draws, std::vector<size_t> &ancestor_indices) const
+{
+  std::vector<double> residual_weights(weights.size());
+  double total_residual_weight = 0;
+  for (size_t i = 0; i < weights.size(); ++i)
+  {
+    double expected_number_of_copies = weights[i] * number_of_draws;
+    size_t number_of_copies = expected_number_of_copies;
+    ancestor_indices.insert(ancestor_indices.end(), number_of_copies, i);
+    residual_weights[i] = expected_number_of_copies - number_of_copies;
+    total_residual_weight += residual_weights[i];
+  }
+  if (ancestor_indices.size() >= number_of_draws || total_residual_weight <= 0.0)
+  {
+    ancestor_indices.resize(std::min(ancestor_indices.size(), number_of_draws), 0);
+    return;
+  }
+
+  for (std::vector<double>::iterator it = residual_weights.begin(); it != residual_weights.end(); ++it)
+  {
+    *it /= total_residual_weight;
+  }
+  this->DrawMultinomialAncestorIndices(residual_weights, number_of_draws - ancestor_indices.size(), ancestor_indices);
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter CalculateConfigurationScoresImplementation
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::CalculateConfigurationScoresImplementation(const tConfiguration *configurations, size_t number_of_configurations, double *scores) const
+{
+  for (size_t i = 0; i < number_of_configurations; ++i)
+  {
+    scores[i] = this->CalculateConfigurationScoreImplementation(configurations[i]);
+  }
+}
+
+//----------------------------------------------------------------------
+// tParticleFilter CalculateConfigurationScores
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::CalculateConfigurationScores(const std::vector<tConfiguration> &configurations, std::vector<double> &scores) const
+{
+  const size_t number_of_configurations = configurations.size();
+  const size_t batch_size = this->scoring_batch_size;
+  scores.resize(number_of_configurations);
+
+  // batches are claimed dynamically, as score functions often take different time for different configurations
+  std::atomic<size_t> next_batch(0);
+  auto score_batches = [this, &configurations, &scores, &next_batch, number_of_configurations, batch_size]()
+  {
+    for (size_t begin = next_batch.fetch_add(batch_size); begin < number_of_configurations; begin = next_batch.fetch_add(batch_size))
+    {
+      size_t end = std::min(begin + batch_size, number_of_configurations);
+      this->CalculateConfigurationScoresImplementation(configurations.data() + begin, end - begin, scores.data() + begin);
+      for (size_t i = begin; i < end; ++i)
+      {
+        assert(scores[i] >= 0.0);
+      }
+    }
+  };
+
+  size_t number_of_workers = std::min<size_t>(this->number_of_threads, (number_of_configurations + batch_size - 1) / batch_size);
+  std::vector<std::thread> workers;
+  workers.reserve(number_of_workers);
+  for (size_t i = 1; i < number_of_workers; ++i)
+  {
+    workers.push_back(std::thread(score_batches));
+  }
+  score_batches();
+  for (std::vector<std::thread>::iterator it = workers.begin(); it != workers.end(); ++it)
+  {
+    it->join();
+  }
 }
 
 //----------------------------------------------------------------------
@@ -152,21 +346,20 @@ void tParticleFilter<TConfiguration>::PerformUpdate()
 {
   if (this->particles.size() < this->number_of_particles)
   {
+    std::vector<tConfiguration> configurations;
+    configurations.reserve(this->number_of_particles - this->particles.size());
     for (size_t i = this->particles.size(); i < this->number_of_particles; ++i)
     {
-      tConfiguration configuration;
-      for (size_t k = 0; k < tConfiguration::cDIMENSION; ++k)
-      {
-        configuration[k] = std::uniform_real_distribution<typename tConfiguration::tElement>(this->lower_bound[k], this->upper_bound[k])(this->rng_engine);
-      }
-      double score = this->CalculateConfigurationScore(configuration);
-      this->particles.push_back(tParticle(configuration, score));
-      RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Generated new particle with configuration ", this->particles.back().Configuration(), " and score ", this->particles.back().Score());
+      configurations.push_back(this->GenerateUniformConfiguration());
     }
-    std::sort(this->particles.begin(), this->particles.end(), [](const tParticle & a, const tParticle & b)
+
+    std::vector<double> scores;
+    this->CalculateConfigurationScores(configurations, scores);
+    for (size_t i = 0; i < configurations.size(); ++i)
     {
-      return a.Score() > b.Score();
-    });
+      this->particles.push_back(tParticle(configurations[i], scores[i]));
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Generated new particle with configuration ", this->particles.back().Configuration(), " and score ", this->particles.back().Score());
+    }
   }
 
   double total_score = 0;
@@ -177,53 +370,58 @@ void tParticleFilter<TConfiguration>::PerformUpdate()
 
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Total score: ", total_score);
 
-  if (total_score > 0.0)
+  std::vector<double> weights;
+  weights.reserve(this->particles.size());
+  for (typename std::vector<tParticle>::iterator it = this->particles.begin(); it != this->particles.end(); ++it)
   {
-    for (typename std::vector<tParticle>::iterator it = this->particles.begin(); it != this->particles.end(); ++it)
-    {
-      it->score /= total_score;
-    }
+    weights.push_back(total_score > 0.0 ? it->Score() / total_score : 0.0);
   }
 
-  size_t resampling_size = this->resampling_ratio * this->number_of_particles;
+  // without any score there is nothing to resample from, so all particles are drawn from the bounds again
+  size_t resampling_size = total_score > 0.0 ? static_cast<size_t>(this->resampling_ratio * this->number_of_particles) : 0;
 
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Resampling ", resampling_size, " particles...");
 
+  std::vector<size_t> ancestor_indices;
+  this->DrawAncestorIndices(weights, resampling_size, ancestor_indices);
+
   std::vector<tConfiguration> new_configurations;
   new_configurations.reserve(this->number_of_particles);
-  for (size_t i = 0; i < resampling_size; ++i)
+  for (std::vector<size_t>::const_iterator it = ancestor_indices.begin(); it != ancestor_indices.end(); ++it)
   {
-    size_t number_of_clones = this->number_of_particles * this->particles[i].score;
-
-    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Resampling ", number_of_clones, " particles from ", this->particles[i].configuration, " with score ", this->particles[i].score, ".");
-
-    number_of_clones = std::min(number_of_clones, resampling_size - new_configurations.size());
-    if (number_of_clones == 0)
-    {
-      break;
-    }
-    for (size_t k = 0; k < number_of_clones; ++k)
-    {
-      new_configurations.push_back(this->GenerateConfiguration(this->particles[i].configuration));
-    }
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Resampling particle from ", this->particles[*it].configuration, " with score ", this->particles[*it].score, ".");
+    new_configurations.push_back(this->GenerateConfiguration(this->particles[*it].configuration));
+  }
+  while (new_configurations.size() < this->number_of_particles)
+  {
+    new_configurations.push_back(this->GenerateUniformConfiguration());
   }
 
+  std::vector<double> new_scores;
+  this->CalculateConfigurationScores(new_configurations, new_scores);
+  this->particles.clear();
   for (size_t i = 0; i < new_configurations.size(); ++i)
   {
-    this->particles[i].configuration = new_configurations[i];
-    this->particles[i].score = this->CalculateConfigurationScore(this->particles[i].configuration);
+    this->particles.push_back(tParticle(new_configurations[i], new_scores[i]));
   }
 
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Resampled ", new_configurations.size(), " particles.");
-
-  typename std::vector<tParticle>::iterator new_end = this->particles.begin();
-  std::advance(new_end, new_configurations.size());
-  this->particles.erase(new_end, this->particles.end());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Resampled ", ancestor_indices.size(), " particles.");
+}
 
-  std::sort(this->particles.begin(), this->particles.end(), [](const tParticle & a, const tParticle & b)
+//----------------------------------------------------------------------
+// tParticleFilter GetRankedParticles
+//----------------------------------------------------------------------
+template <typename TConfiguration>
+void tParticleFilter<TConfiguration>::GetRankedParticles(std::vector<tParticle> &ranked_particles, size_t max_number_of_particles) const
+{
+  ranked_particles = this->particles;
+  typename std::vector<tParticle>::iterator middle = ranked_particles.begin();
+  std::advance(middle, std::min(max_number_of_particles, ranked_particles.size()));
+  std::partial_sort(ranked_particles.begin(), middle, ranked_particles.end(), [](const tParticle & a, const tParticle & b)
   {
     return a.Score() > b.Score();
   });
+  ranked_particles.erase(middle, ranked_particles.end());
 }
 
 //----------------------------------------------------------------------
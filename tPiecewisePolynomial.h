@@ -0,0 +1,198 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPiecewisePolynomial.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPiecewisePolynomial
+ *
+ * \b tPiecewisePolynomial
+ *
+ * Optimal piecewise polynomial approximation of a 1-D signal using
+ * penalized dynamic programming with PELT pruning.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPiecewisePolynomial_h__
+#define __rrlib__model_fitting__tPiecewisePolynomial_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tPolynomial.h"
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+#include "rrlib/model_fitting/tPolynomialMomentIndex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Optimal segmentation of a 1-D signal into polynomial pieces
+/*! Finds the breakpoints that minimize the sum of the residual sums of
+ *  squares of least squares polynomials of degree Tdegree over all
+ *  segments plus a penalty per segment. The optimum is computed by
+ *  dynamic programming with PELT pruning (Killick et al., 2012), which is
+ *  exact since splitting a segment never increases its residual sum of
+ *  squares.
+ *
+ *  Segment costs are range queries of a tPolynomialMomentIndex over the
+ *  sorted samples, which re-centres and scales the power sums of each
+ *  range, so no candidate keeps or updates sums of its own. As the
+ *  residual sum of squares of [s, t) never decreases with t, the cost of
+ *  a candidate evaluated at some earlier t is a lower bound for its cost
+ *  now. Candidates are kept in a heap of these bounds and re-evaluated
+ *  only while their bound is below the best cost found for the current
+ *  t. PELT pruning applies to the re-evaluated candidates. It takes
+ *  effect min_segment_length samples late, because the candidate that
+ *  prunes another one is not available any earlier.
+ *
+ *  PELT keeps the number of candidates linear in the number of samples
+ *  if the number of segments grows with the signal length. Within long
+ *  homogeneous segments, however, no candidate can be pruned, and each
+ *  one is re-evaluated about every penalty / sigma^2 samples. In that
+ *  case, a maximal segment length bounds the number of candidates.
+ *  Every sample still takes a few range queries of some hundred
+ *  nanoseconds, so 1e5 samples take a fraction of a second rather than
+ *  milliseconds.
+ *
+ *  A good penalty is in the order of (Tdegree + 1) * sigma^2 * ln(N) for
+ *  noise with standard deviation sigma.
+ */
+template <size_t Tdegree>
+class tPiecewisePolynomial
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVec2d tSample;
+
+  struct tSegment
+  {
+    size_t first;                            //!< Index of the first sample (in order of increasing x)
+    size_t last;                             //!< Index after the last sample
+    double x_min;
+    double x_max;
+    math::tPolynomial<Tdegree> polynomial;   //!< Relative to x_min
+    double residual_sum_of_squares;
+  };
+
+  tPiecewisePolynomial();
+
+  template <typename TIterator>
+  tPiecewisePolynomial(TIterator begin, TIterator end, double penalty, size_t min_segment_length = Tdegree + 1, size_t max_segment_length = 0);
+
+  /*!
+   * \brief Segment the given samples (they are sorted by x if they are not, yet)
+   *
+   * \param penalty              The cost of an additional segment
+   * \param min_segment_length   The minimal number of samples per segment (at least Tdegree + 1)
+   * \param max_segment_length   The maximal number of samples per segment (0 for no limit)
+   *
+   * \return Whether a segmentation was found
+   */
+  template <typename TIterator>
+  const bool UpdateModelFromSampleSet(TIterator begin, TIterator end, double penalty, size_t min_segment_length = Tdegree + 1, size_t max_segment_length = 0);
+
+  inline const std::vector<tSegment> &Segments() const
+  {
+    return this->segments;
+  }
+
+  /*!
+   * \brief The total residual sum of squares plus one penalty per segment
+   */
+  inline double Cost() const
+  {
+    return this->cost;
+  }
+
+  /*!
+   * \brief Evaluate the segment that contains x (or the nearest one)
+   */
+  double operator()(double x) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cCHUNK_SIZE = 128 };
+
+  struct tCandidate
+  {
+    size_t start;
+    size_t expiry;   // pruned from then on
+    double cost;     // lower bound of the optimal cost up to start plus the residual sum of squares of [start, t)
+  };
+
+  tPolynomialMomentIndex<Tdegree> index;
+  std::vector<tSegment> segments;
+  double cost;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tPiecewisePolynomial";
+  }
+
+  /*!
+   * \brief The residual sum of squares of [first, last), or zero if the range cannot be fitted
+   */
+  double LowerBound(size_t first, size_t last) const;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPiecewisePolynomial.hpp"
+
+#endif
@@ -0,0 +1,298 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPiecewisePolynomial.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPiecewisePolynomial constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPiecewisePolynomial<Tdegree>::tPiecewisePolynomial()
+  : cost(0)
+{}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tPiecewisePolynomial<Tdegree>::tPiecewisePolynomial(TIterator begin, TIterator end, double penalty, size_t min_segment_length, size_t max_segment_length)
+  : cost(0)
+{
+  if (!this->UpdateModelFromSampleSet(begin, end, penalty, min_segment_length, max_segment_length))
+  {
+    throw std::runtime_error("Failed to segment samples during construction!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tPiecewisePolynomial UpdateModelFromSampleSet
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+const bool tPiecewisePolynomial<Tdegree>::UpdateModelFromSampleSet(TIterator begin, TIterator end, double penalty, size_t min_segment_length, size_t max_segment_length)
+{
+  this->segments.clear();
+  this->cost = 0;
+
+  this->index.Build(begin, end);
+
+  min_segment_length = std::max<size_t>(min_segment_length, Tdegree + 1);
+  const size_t n = this->index.NumberOfSamples();
+  if (n < min_segment_length)
+  {
+    RRLIB_LOG_PRINT(ERROR, "At least ", min_segment_length, " samples are needed for segmentation!");
+    return false;
+  }
+
+  /*
+   * F(t) = min_{s in R} F(s) + C(s, t) + penalty, where C(s, t) is the
+   * residual sum of squares of the samples [s, t). If F(s) + C(s, t) > F(t),
+   * candidate t is better than s for all T >= t + min_segment_length,
+   * so s expires from R at that point.
+   */
+  const double cINFINITY = std::numeric_limits<double>::infinity();
+  std::vector<double> optimal_cost(n + 1, cINFINITY);
+  std::vector<size_t> last_breakpoint(n + 1, 0);
+  optimal_cost[0] = -penalty;
+
+  /*
+   * Splitting a range never increases its residual sum of squares, so
+   * C(s, t) >= C(s, u) + G(t) - G(u) for u <= t on a grid of cCHUNK_SIZE,
+   * where G(t) sums the residual sums of squares of all chunks up to t.
+   * Candidates that started before the last grid point are kept in a
+   * heap of F(s) + C(s, u) - G(u), whose order does not change with t.
+   * Younger candidates are kept in a heap of their last evaluated cost.
+   */
+  std::vector<double> chunk_costs(n / cCHUNK_SIZE + 1, 0.0);
+  for (size_t k = 0; k + 1 < chunk_costs.size(); ++k)
+  {
+    chunk_costs[k + 1] = chunk_costs[k] + this->LowerBound(k * cCHUNK_SIZE, (k + 1) * cCHUNK_SIZE);
+  }
+
+  // min-heaps, ties go to the earlier start
+  auto later = [](const tCandidate & a, const tCandidate & b)
+  {
+    return a.cost > b.cost || (a.cost == b.cost && a.start > b.start);
+  };
+  std::vector<tCandidate> young_candidates;
+  std::vector<tCandidate> old_candidates;
+  std::vector<tCandidate> evaluated_candidates;
+  for (size_t t = min_segment_length; t <= n; ++t)
+  {
+    const size_t grid_point = t - t % cCHUNK_SIZE;
+    const double chunk_cost = chunk_costs[grid_point / cCHUNK_SIZE] + this->LowerBound(grid_point, t);
+
+    evaluated_candidates.clear();
+    double best_cost = cINFINITY;
+    size_t best_start = 0;
+
+    size_t new_start = t - min_segment_length;
+    if (optimal_cost[new_start] < cINFINITY)
+    {
+      tCandidate candidate;
+      candidate.start = new_start;
+      candidate.expiry = n + 1;
+      candidate.cost = optimal_cost[new_start] + this->index.ResidualSumOfSquares(new_start, t);
+      evaluated_candidates.push_back(candidate);
+      best_cost = candidate.cost;
+      best_start = new_start;
+    }
+
+    while (true)
+    {
+      bool young = !young_candidates.empty() && young_candidates.front().cost <= best_cost;
+      bool old = !old_candidates.empty() && old_candidates.front().cost + chunk_cost <= best_cost;
+      if (young && old)
+      {
+        young = young_candidates.front().cost <= old_candidates.front().cost + chunk_cost;
+      }
+      else if (!young && !old)
+      {
+        break;
+      }
+      std::vector<tCandidate> &heap = young ? young_candidates : old_candidates;
+      std::pop_heap(heap.begin(), heap.end(), later);
+      tCandidate candidate = heap.back();
+      heap.pop_back();
+      if (t >= candidate.expiry || (max_segment_length > 0 && t - candidate.start > max_segment_length))
+      {
+        continue;
+      }
+
+      candidate.cost = optimal_cost[candidate.start] + this->index.ResidualSumOfSquares(candidate.start, t);
+      evaluated_candidates.push_back(candidate);
+      if (candidate.cost < best_cost || (candidate.cost == best_cost && candidate.start < best_start))
+      {
+        best_cost = candidate.cost;
+        best_start = candidate.start;
+      }
+    }
+
+    if (best_cost < cINFINITY)
+    {
+      optimal_cost[t] = best_cost + penalty;
+      last_breakpoint[t] = best_start;
+    }
+
+    // PELT pruning; a degenerate range may become solvable later, so its bound falls back to F(s)
+    for (typename std::vector<tCandidate>::iterator it = evaluated_candidates.begin(); it != evaluated_candidates.end(); ++it)
+    {
+      if (it->cost > optimal_cost[t] && it->cost < cINFINITY)
+      {
+        it->expiry = std::min(it->expiry, t + min_segment_length);
+      }
+      if (it->cost == cINFINITY)
+      {
+        it->cost = optimal_cost[it->start];
+      }
+      else if (it->start <= grid_point)
+      {
+        double residual_sum_of_squares = grid_point == t ? it->cost - optimal_cost[it->start] : this->LowerBound(it->start, grid_point);
+        it->cost = optimal_cost[it->start] + residual_sum_of_squares - chunk_costs[grid_point / cCHUNK_SIZE];
+        old_candidates.push_back(*it);
+        std::push_heap(old_candidates.begin(), old_candidates.end(), later);
+        continue;
+      }
+      young_candidates.push_back(*it);
+      std::push_heap(young_candidates.begin(), young_candidates.end(), later);
+    }
+  }
+
+  if (!(optimal_cost[n] < cINFINITY))
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to segment samples.");
+    return false;
+  }
+  // F(0) = -penalty only made F(n) count the penalties of the breakpoints
+  this->cost = optimal_cost[n] + penalty;
+
+  std::vector<size_t> breakpoints;
+  for (size_t t = n; t > 0; t = last_breakpoint[t])
+  {
+    breakpoints.push_back(t);
+  }
+  breakpoints.push_back(0);
+  std::reverse(breakpoints.begin(), breakpoints.end());
+
+  for (size_t i = 0; i + 1 < breakpoints.size(); ++i)
+  {
+    tSegment segment;
+    segment.first = breakpoints[i];
+    segment.last = breakpoints[i + 1];
+    segment.x_min = this->index.X(segment.first);
+    segment.x_max = this->index.X(segment.last - 1);
+
+    double offset, scale;
+    tPolynomialMoments<Tdegree> moments = this->index.Moments(segment.first, segment.last, offset, scale);
+    double l[Tdegree + 1][Tdegree + 1];
+    double z[Tdegree + 1];
+    if (moments.DecomposeNormalEquations(l, z) < Tdegree + 1)
+    {
+      RRLIB_LOG_PRINT(ERROR, "Failed to fit segment [", segment.first, ", ", segment.last, ").");
+      this->segments.clear();
+      return false;
+    }
+    math::tVector < Tdegree + 1, double > coefficients;
+    tPolynomialMoments<Tdegree>::SolveDecomposedNormalEquations(l, z, Tdegree + 1, coefficients);
+    tLeastSquaresPolynomial<Tdegree>::ExpandNormalizedPolynomial(coefficients, offset - segment.x_min, scale, segment.polynomial);
+    segment.residual_sum_of_squares = moments.ResidualSumOfSquares(coefficients);
+
+    this->segments.push_back(segment);
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Found ", this->segments.size(), " segments with total cost ", this->cost);
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tPiecewisePolynomial LowerBound
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPiecewisePolynomial<Tdegree>::LowerBound(size_t first, size_t last) const
+{
+  double residual_sum_of_squares = this->index.ResidualSumOfSquares(first, last);
+  return residual_sum_of_squares < std::numeric_limits<double>::infinity() ? residual_sum_of_squares : 0;
+}
+
+//----------------------------------------------------------------------
+// tPiecewisePolynomial operator ()
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPiecewisePolynomial<Tdegree>::operator()(double x) const
+{
+  assert(!this->segments.empty());
+  typename std::vector<tSegment>::const_iterator it = this->segments.begin();
+  while (it + 1 != this->segments.end() && x > 0.5 * (it->x_max + (it + 1)->x_min))
+  {
+    ++it;
+  }
+  return it->polynomial(x - it->x_min);
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
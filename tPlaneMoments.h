@@ -0,0 +1,187 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPlaneMoments.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPlaneMoments
+ *
+ * \b tPlaneMoments
+ *
+ * Accumulated first and second moments of 3D points for incremental
+ * least squares plane fitting.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPlaneMoments_h__
+#define __rrlib__model_fitting__tPlaneMoments_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+
+#include "rrlib/geometry/tPlane.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! First and second moments of a point set for plane fitting
+/*! Holds n, S(pi) and S(pi*pi^T) of a set of 3D points. Points can be
+ *  added and removed in constant time and accumulators can be merged, so
+ *  that the least squares plane of a changing point set, e.g. during
+ *  region growing or local optimization of RANSAC, never has to be
+ *  recomputed from scratch. Merging also combines partial results of
+ *  several threads.
+ *
+ *  The sums are kept relative to the first point that was added, which
+ *  avoids cancellation for point sets far from the origin.
+ */
+template <typename TElement = double>
+class tPlaneMoments
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename geometry::tPlane<3, TElement>::tPoint tPoint;
+
+  tPlaneMoments();
+
+  template <typename TIterator>
+  tPlaneMoments(TIterator begin, TIterator end);
+
+  void Clear();
+
+  inline void Add(const tPoint &point)
+  {
+    this->Add(point, 1.0);
+  }
+
+  /*!
+   * \brief Add a point with the given weight for weighted least squares
+   *
+   * Points with zero weight are ignored.
+   */
+  void Add(const tPoint &point, double weight);
+
+  inline void Remove(const tPoint &point)
+  {
+    assert(this->number_of_samples > 0);
+    this->Accumulate(point, -1.0);
+    this->number_of_samples--;
+  }
+
+  template <typename TIterator>
+  void Add(TIterator begin, TIterator end);
+
+  tPlaneMoments &operator += (const tPlaneMoments &other);
+
+  tPlaneMoments &operator -= (const tPlaneMoments &other);
+
+  inline size_t NumberOfSamples() const
+  {
+    return this->number_of_samples;
+  }
+
+  /*!
+   * \brief The sum of the weights, which equals NumberOfSamples() for unweighted points
+   */
+  inline double TotalWeight() const
+  {
+    return this->total_weight;
+  }
+
+  tPoint CenterOfGravity() const;
+
+  /*!
+   * \brief S((pi - c)*(pi - c)^T) around the center of gravity c
+   */
+  void GetScatterMatrix(double(&scatter)[3][3]) const;
+
+  /*!
+   * \brief Fit the least squares plane through the center of gravity
+   *
+   * The normal is the weakest principal component, oriented like the
+   * current normal of the given plane.
+   *
+   * \param plane                     The plane to set
+   * \param residual_sum_of_squares   The sum of the squared distances of the points to the plane (may be 0)
+   *
+   * \return Whether the points determine a unique plane, i.e. are not (nearly) collinear
+   */
+  const bool GetPlane(geometry::tPlane<3, TElement> &plane, double *residual_sum_of_squares = NULL) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  size_t number_of_samples;
+  double total_weight;
+  double reference[3];
+  double sums[3];
+  double square_sums[3][3];
+
+  void Accumulate(const tPoint &point, double weight);
+
+  /*!
+   * \brief Move the sums to a new reference point
+   */
+  void SetReference(const double(&new_reference)[3]);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPlaneMoments.hpp"
+
+#endif
@@ -0,0 +1,299 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPlaneMoments.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/symmetric_eigen_decomposition_3x3.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPlaneMoments constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tPlaneMoments<TElement>::tPlaneMoments()
+{
+  this->Clear();
+}
+
+template <typename TElement>
+template <typename TIterator>
+tPlaneMoments<TElement>::tPlaneMoments(TIterator begin, TIterator end)
+{
+  this->Clear();
+  this->Add(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments Clear
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPlaneMoments<TElement>::Clear()
+{
+  this->number_of_samples = 0;
+  this->total_weight = 0;
+  std::fill(this->reference, this->reference + 3, 0.0);
+  std::fill(this->sums, this->sums + 3, 0.0);
+  std::fill(&this->square_sums[0][0], &this->square_sums[0][0] + 9, 0.0);
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments Add
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPlaneMoments<TElement>::Add(const tPoint &point, double weight)
+{
+  assert(weight >= 0);
+  if (!(weight > 0))
+  {
+    return;
+  }
+  if (this->number_of_samples == 0)
+  {
+    this->Clear();
+    this->reference[0] = point.X();
+    this->reference[1] = point.Y();
+    this->reference[2] = point.Z();
+  }
+  this->Accumulate(point, weight);
+  this->number_of_samples++;
+}
+
+template <typename TElement>
+template <typename TIterator>
+void tPlaneMoments<TElement>::Add(TIterator begin, TIterator end)
+{
+  for (TIterator it = begin; it != end; ++it)
+  {
+    this->Add(*it, 1.0);
+  }
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments Accumulate
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPlaneMoments<TElement>::Accumulate(const tPoint &point, double weight)
+{
+  double p[3] = { point.X() - this->reference[0], point.Y() - this->reference[1], point.Z() - this->reference[2] };
+  this->total_weight += weight;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    this->sums[i] += weight * p[i];
+    for (size_t j = i; j < 3; ++j)
+    {
+      this->square_sums[i][j] += weight * p[i] * p[j];
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments SetReference
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPlaneMoments<TElement>::SetReference(const double(&new_reference)[3])
+{
+  // with d = r_old - r_new: S(p - r_new) = S(p - r_old) + w * d and
+  // S((p - r_new)(p - r_new)^T) = S((p - r_old)(p - r_old)^T) + S(p - r_old) * d^T + d * S(p - r_old)^T + w * d * d^T
+  double d[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    d[i] = this->reference[i] - new_reference[i];
+  }
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = i; j < 3; ++j)
+    {
+      this->square_sums[i][j] += this->sums[i] * d[j] + d[i] * this->sums[j] + this->total_weight * d[i] * d[j];
+    }
+  }
+  for (size_t i = 0; i < 3; ++i)
+  {
+    this->sums[i] += this->total_weight * d[i];
+    this->reference[i] = new_reference[i];
+  }
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments operator +=
+//----------------------------------------------------------------------
+template <typename TElement>
+tPlaneMoments<TElement> &tPlaneMoments<TElement>::operator += (const tPlaneMoments &other)
+{
+  if (other.number_of_samples == 0)
+  {
+    return *this;
+  }
+  if (this->number_of_samples == 0)
+  {
+    return *this = other;
+  }
+  tPlaneMoments shifted(other);
+  shifted.SetReference(this->reference);
+  this->number_of_samples += shifted.number_of_samples;
+  this->total_weight += shifted.total_weight;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    this->sums[i] += shifted.sums[i];
+    for (size_t j = i; j < 3; ++j)
+    {
+      this->square_sums[i][j] += shifted.square_sums[i][j];
+    }
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments operator -=
+//----------------------------------------------------------------------
+template <typename TElement>
+tPlaneMoments<TElement> &tPlaneMoments<TElement>::operator -= (const tPlaneMoments &other)
+{
+  assert(this->number_of_samples >= other.number_of_samples);
+  if (other.number_of_samples == 0)
+  {
+    return *this;
+  }
+  tPlaneMoments shifted(other);
+  shifted.SetReference(this->reference);
+  this->number_of_samples -= shifted.number_of_samples;
+  this->total_weight -= shifted.total_weight;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    this->sums[i] -= shifted.sums[i];
+    for (size_t j = i; j < 3; ++j)
+    {
+      this->square_sums[i][j] -= shifted.square_sums[i][j];
+    }
+  }
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments CenterOfGravity
+//----------------------------------------------------------------------
+template <typename TElement>
+typename tPlaneMoments<TElement>::tPoint tPlaneMoments<TElement>::CenterOfGravity() const
+{
+  assert(this->total_weight > 0);
+  return tPoint(this->reference[0] + this->sums[0] / this->total_weight,
+                this->reference[1] + this->sums[1] / this->total_weight,
+                this->reference[2] + this->sums[2] / this->total_weight);
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments GetScatterMatrix
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPlaneMoments<TElement>::GetScatterMatrix(double(&scatter)[3][3]) const
+{
+  assert(this->total_weight > 0);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    for (size_t j = i; j < 3; ++j)
+    {
+      scatter[i][j] = scatter[j][i] = this->square_sums[i][j] - this->sums[i] * this->sums[j] / this->total_weight;
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// tPlaneMoments GetPlane
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tPlaneMoments<TElement>::GetPlane(geometry::tPlane<3, TElement> &plane, double *residual_sum_of_squares) const
+{
+  if (this->number_of_samples < 3 || !(this->total_weight > 0))
+  {
+    return false;
+  }
+
+  double scatter[3][3];
+  this->GetScatterMatrix(scatter);
+
+  double eigenvalues[3];
+  double eigenvectors[3][3];
+  DecomposeSymmetric3x3(scatter, eigenvalues, eigenvectors);
+
+  // the weakest component is only well-defined if the points span two dimensions
+  if (!(eigenvalues[1] > std::numeric_limits<double>::epsilon() * eigenvalues[2] * 16))
+  {
+    return false;
+  }
+
+  tPoint normal(eigenvectors[0][0], eigenvectors[0][1], eigenvectors[0][2]);
+  plane.Set(this->CenterOfGravity(), normal * plane.Normal() < 0 ? -normal : normal);
+
+  if (residual_sum_of_squares)
+  {
+    *residual_sum_of_squares = std::max(eigenvalues[0], 0.0);
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
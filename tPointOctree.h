@@ -0,0 +1,195 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPointOctree.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPointOctree
+ *
+ * \b tPointOctree
+ *
+ * A few words for tPointOctree
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPointOctree_h__
+#define __rrlib__model_fitting__tPointOctree_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Octree over a static point set with tight bounding boxes
+/*! The points are not stored, only a permutation of their indices in
+ *  which the points of every node form a contiguous range. Cells are
+ *  split at their centers until they hold at most max_leaf_size points
+ *  or reach max_depth, so that nodes of the same depth are cubes of the
+ *  same size. Every node additionally keeps the tight bounding box of its
+ *  points for geometric queries.
+ */
+template <typename TElement = double>
+class tPointOctree
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVector<3, TElement> tPoint;
+
+  struct tNode
+  {
+    tPoint min;
+    tPoint max;
+    size_t begin;
+    size_t end;
+    size_t parent;
+    size_t first_child;
+    unsigned char number_of_children;
+    unsigned char depth;
+  };
+
+  tPointOctree();
+
+  /*!
+   * \param begin, end       Random access iterators to points with X(), Y() and Z()
+   * \param max_leaf_size    The number of points at which a cell is not split anymore
+   * \param max_depth        The depth at which cells are not split anymore, e.g. for duplicate points
+   */
+  template <typename TIterator>
+  tPointOctree(TIterator begin, TIterator end, size_t max_leaf_size = 32, unsigned int max_depth = 16);
+
+  template <typename TIterator>
+  void Build(TIterator begin, TIterator end, size_t max_leaf_size = 32, unsigned int max_depth = 16);
+
+  inline size_t NumberOfPoints() const
+  {
+    return this->indices.size();
+  }
+
+  /*!
+   * \brief The point indices in an order in which every node covers the range [begin, end)
+   */
+  inline const std::vector<size_t> &Indices() const
+  {
+    return this->indices;
+  }
+
+  /*!
+   * \brief The nodes in depth-first order, starting with the root
+   */
+  inline const std::vector<tNode> &Nodes() const
+  {
+    return this->nodes;
+  }
+
+  /*!
+   * \brief The maximal depth of all leaves, which is 0 for a single leaf
+   */
+  inline unsigned int Depth() const
+  {
+    return this->depth;
+  }
+
+  /*!
+   * \brief The index of the leaf that contains the point with the given index
+   */
+  inline size_t Leaf(size_t point_index) const
+  {
+    return this->leaves[point_index];
+  }
+
+  /*!
+   * \brief The index of the node with the given depth that contains the point with the given index
+   *
+   * Depths beyond the leaf of the point yield the leaf.
+   */
+  size_t Ancestor(size_t point_index, unsigned int depth) const;
+
+  /*!
+   * \brief Get the indices of all points in cells that intersect the slab |normal * p - distance| <= max_error
+   *
+   * Cells entirely outside the slab are skipped and cells entirely inside
+   * are taken as a whole, so that the cost is proportional to the number
+   * of points in the slab plus the cells crossing its boundary. Points of
+   * leaves that cross the boundary may lie outside the slab.
+   *
+   * \param normal      The unit normal of the plane in the middle of the slab
+   * \param distance    The distance of that plane from the origin along the normal
+   * \param max_error   Half the thickness of the slab
+   * \param indices     The point indices in the order of Indices()
+   */
+  void GetSlabPointIndices(const tPoint &normal, TElement distance, TElement max_error, std::vector<size_t> &indices) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<tNode> nodes;
+  std::vector<size_t> indices;
+  std::vector<size_t> leaves;
+  unsigned int depth;
+
+  template <typename TIterator>
+  void Split(TIterator begin, size_t node, const double(&center)[3], double half_size, size_t max_leaf_size, unsigned int max_depth);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPointOctree.hpp"
+
+#endif
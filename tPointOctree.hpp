@@ -0,0 +1,280 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPointOctree.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <iterator>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPointOctree constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tPointOctree<TElement>::tPointOctree()
+  : depth(0)
+{}
+
+template <typename TElement>
+template <typename TIterator>
+tPointOctree<TElement>::tPointOctree(TIterator begin, TIterator end, size_t max_leaf_size, unsigned int max_depth)
+  : depth(0)
+{
+  this->Build(begin, end, max_leaf_size, max_depth);
+}
+
+//----------------------------------------------------------------------
+// tPointOctree Build
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+void tPointOctree<TElement>::Build(TIterator begin, TIterator end, size_t max_leaf_size, unsigned int max_depth)
+{
+  size_t number_of_points = std::distance(begin, end);
+  this->nodes.clear();
+  this->indices.resize(number_of_points);
+  this->leaves.assign(number_of_points, 0);
+  this->depth = 0;
+  if (number_of_points == 0)
+  {
+    return;
+  }
+
+  tNode root;
+  root.min = tPoint(begin->X(), begin->Y(), begin->Z());
+  root.max = root.min;
+  size_t i = 0;
+  for (TIterator it = begin; it != end; ++it, ++i)
+  {
+    this->indices[i] = i;
+    root.min = tPoint(std::min<TElement>(root.min.X(), it->X()), std::min<TElement>(root.min.Y(), it->Y()), std::min<TElement>(root.min.Z(), it->Z()));
+    root.max = tPoint(std::max<TElement>(root.max.X(), it->X()), std::max<TElement>(root.max.Y(), it->Y()), std::max<TElement>(root.max.Z(), it->Z()));
+  }
+  root.begin = 0;
+  root.end = number_of_points;
+  root.parent = 0;
+  root.first_child = 0;
+  root.number_of_children = 0;
+  root.depth = 0;
+  this->nodes.push_back(root);
+
+  double center[3] = { 0.5 * (root.min.X() + root.max.X()), 0.5 * (root.min.Y() + root.max.Y()), 0.5 * (root.min.Z() + root.max.Z()) };
+  double half_size = 0.5 * std::max<double>(root.max.X() - root.min.X(), std::max<double>(root.max.Y() - root.min.Y(), root.max.Z() - root.min.Z()));
+  this->Split(begin, 0, center, half_size, max_leaf_size, max_depth);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Built octree with ", this->nodes.size(), " nodes and depth ", this->depth, " for ", number_of_points, " points.");
+}
+
+//----------------------------------------------------------------------
+// tPointOctree Split
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TIterator>
+void tPointOctree<TElement>::Split(TIterator begin, size_t node, const double(&center)[3], double half_size, size_t max_leaf_size, unsigned int max_depth)
+{
+  const size_t range_begin = this->nodes[node].begin;
+  const size_t range_end = this->nodes[node].end;
+  const unsigned int node_depth = this->nodes[node].depth;
+  this->depth = std::max(this->depth, node_depth);
+
+  if (range_end - range_begin <= max_leaf_size || node_depth >= max_depth || half_size <= 0)
+  {
+    for (size_t i = range_begin; i < range_end; ++i)
+    {
+      this->leaves[this->indices[i]] = node;
+    }
+    return;
+  }
+
+  // counting sort of the range by octant
+  std::vector<unsigned char> octants(range_end - range_begin);
+  size_t counts[8] = {};
+  for (size_t i = range_begin; i < range_end; ++i)
+  {
+    TIterator it = begin;
+    std::advance(it, this->indices[i]);
+    unsigned char octant = (it->X() >= center[0] ? 1 : 0) | (it->Y() >= center[1] ? 2 : 0) | (it->Z() >= center[2] ? 4 : 0);
+    octants[i - range_begin] = octant;
+    counts[octant]++;
+  }
+  size_t offsets[9] = { range_begin };
+  for (size_t k = 0; k < 8; ++k)
+  {
+    offsets[k + 1] = offsets[k] + counts[k];
+  }
+  std::vector<size_t> sorted(range_end - range_begin);
+  size_t positions[8];
+  std::copy(offsets, offsets + 8, positions);
+  for (size_t i = range_begin; i < range_end; ++i)
+  {
+    sorted[positions[octants[i - range_begin]]++ - range_begin] = this->indices[i];
+  }
+  std::copy(sorted.begin(), sorted.end(), this->indices.begin() + range_begin);
+
+  // children are stored contiguously, before any of them is split
+  size_t first_child = this->nodes.size();
+  unsigned char number_of_children = 0;
+  for (size_t k = 0; k < 8; ++k)
+  {
+    if (counts[k] == 0)
+    {
+      continue;
+    }
+    tNode child;
+    TIterator it = begin;
+    std::advance(it, this->indices[offsets[k]]);
+    child.min = tPoint(it->X(), it->Y(), it->Z());
+    child.max = child.min;
+    for (size_t i = offsets[k] + 1; i < offsets[k + 1]; ++i)
+    {
+      it = begin;
+      std::advance(it, this->indices[i]);
+      child.min = tPoint(std::min<TElement>(child.min.X(), it->X()), std::min<TElement>(child.min.Y(), it->Y()), std::min<TElement>(child.min.Z(), it->Z()));
+      child.max = tPoint(std::max<TElement>(child.max.X(), it->X()), std::max<TElement>(child.max.Y(), it->Y()), std::max<TElement>(child.max.Z(), it->Z()));
+    }
+    child.begin = offsets[k];
+    child.end = offsets[k + 1];
+    child.parent = node;
+    child.first_child = 0;
+    child.number_of_children = 0;
+    child.depth = node_depth + 1;
+    this->nodes.push_back(child);
+    number_of_children++;
+  }
+  this->nodes[node].first_child = first_child;
+  this->nodes[node].number_of_children = number_of_children;
+
+  double quarter_size = 0.5 * half_size;
+  size_t child = first_child;
+  for (size_t k = 0; k < 8; ++k)
+  {
+    if (counts[k] == 0)
+    {
+      continue;
+    }
+    double child_center[3] =
+    {
+      center[0] + (k & 1 ? quarter_size : -quarter_size),
+      center[1] + (k & 2 ? quarter_size : -quarter_size),
+      center[2] + (k & 4 ? quarter_size : -quarter_size)
+    };
+    this->Split(begin, child++, child_center, quarter_size, max_leaf_size, max_depth);
+  }
+}
+
+//----------------------------------------------------------------------
+// tPointOctree Ancestor
+//----------------------------------------------------------------------
+template <typename TElement>
+size_t tPointOctree<TElement>::Ancestor(size_t point_index, unsigned int depth) const
+{
+  size_t node = this->leaves[point_index];
+  while (this->nodes[node].depth > depth)
+  {
+    node = this->nodes[node].parent;
+  }
+  return node;
+}
+
+//----------------------------------------------------------------------
+// tPointOctree GetSlabPointIndices
+//----------------------------------------------------------------------
+template <typename TElement>
+void tPointOctree<TElement>::GetSlabPointIndices(const tPoint &normal, TElement distance, TElement max_error, std::vector<size_t> &indices) const
+{
+  indices.clear();
+  if (this->nodes.empty())
+  {
+    return;
+  }
+
+  std::vector<size_t> stack(1, 0);
+  while (!stack.empty())
+  {
+    const tNode &node = this->nodes[stack.back()];
+    stack.pop_back();
+
+    // the signed distances of the box corners lie in [center_distance - radius, center_distance + radius]
+    TElement center_distance = normal.X() * 0.5 * (node.min.X() + node.max.X()) + normal.Y() * 0.5 * (node.min.Y() + node.max.Y()) + normal.Z() * 0.5 * (node.min.Z() + node.max.Z()) - distance;
+    TElement radius = 0.5 * (std::fabs(normal.X()) * (node.max.X() - node.min.X()) + std::fabs(normal.Y()) * (node.max.Y() - node.min.Y()) + std::fabs(normal.Z()) * (node.max.Z() - node.min.Z()));
+    if (std::fabs(center_distance) - radius > max_error)
+    {
+      continue;
+    }
+    if (std::fabs(center_distance) + radius <= max_error || node.number_of_children == 0)
+    {
+      indices.insert(indices.end(), this->indices.begin() + node.begin, this->indices.begin() + node.end);
+      continue;
+    }
+    for (size_t child = node.first_child; child < node.first_child + node.number_of_children; ++child)
+    {
+      stack.push_back(child);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
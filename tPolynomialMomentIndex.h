@@ -0,0 +1,224 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialMomentIndex.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPolynomialMomentIndex
+ *
+ * \b tPolynomialMomentIndex
+ *
+ * Prefix sums of polynomial power sums over sorted samples for fits
+ * over arbitrary x-intervals.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPolynomialMomentIndex_h__
+#define __rrlib__model_fitting__tPolynomialMomentIndex_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tPolynomial.h"
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPolynomialMoments.h"
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Prefix sums of polynomial power sums for range fits
+/*! Built once over a set of samples sorted by x, this index answers the
+ *  power sums of any contiguous range of samples without visiting its
+ *  samples. Thus, the least squares polynomial over an x-interval and
+ *  its residual sum of squares cost O(Tdegree^2) per level of the index
+ *  (plus a binary search) independent of the number of samples in the
+ *  range.
+ *
+ *  Differences of global prefix sums cancel catastrophically for short
+ *  ranges far from the origin. Therefore, the samples are grouped into
+ *  blocks of cBLOCK_SIZE, the blocks into blocks of cBLOCK_SIZE blocks
+ *  and so on, and each level stores prefix and suffix sums within each
+ *  block, each relative to the center of the x-range it covers. A range
+ *  is assembled from at most two such rows per level, which lie within
+ *  the range (except for the topmost level) and are shifted to its
+ *  center and scaled to its half-width with the binomial theorem.
+ *  Ranges within a single block are summed directly. With compensated
+ *  summation the rows are accumulated with Kahan summation.
+ *
+ *  Moments() returns these normalized power sums together with their
+ *  offset and scale. Fitted polynomials are expressed relative to
+ *  Origin().
+ */
+template <size_t Tdegree>
+class tPolynomialMomentIndex
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVec2d tSample;
+  typedef model_fitting::tPolynomialMoments<Tdegree> tMoments;
+
+  explicit tPolynomialMomentIndex(bool compensated_summation = false);
+
+  template <typename TIterator>
+  tPolynomialMomentIndex(TIterator begin, TIterator end, bool compensated_summation = false);
+
+  /*!
+   * \brief Build the index (samples are sorted by x if they are not, yet)
+   */
+  template <typename TIterator>
+  void Build(TIterator begin, TIterator end);
+
+  inline size_t NumberOfSamples() const
+  {
+    return this->x_values.size();
+  }
+
+  inline double Origin() const
+  {
+    return this->origin;
+  }
+
+  /*!
+   * \brief The x value of the sample with the given index in sorted order
+   */
+  inline double X(size_t index) const
+  {
+    return this->x_values[index];
+  }
+
+  /*!
+   * \brief Get the index range [first, last) of all samples with x_min <= x <= x_max
+   */
+  void GetIndexRange(double x_min, double x_max, size_t &first, size_t &last) const;
+
+  /*!
+   * \brief Get the power sums of the samples [first, last) in normalized x
+   *
+   * \param offset   The center of the x-range of the samples, i.e. normalized x is (x - offset) / scale
+   * \param scale    The half-width of the x-range of the samples (or 1 if it is empty)
+   */
+  tMoments Moments(size_t first, size_t last, double &offset, double &scale) const;
+
+  /*!
+   * \brief Fit a polynomial (relative to Origin()) to the samples [first, last)
+   *
+   * \return Whether the normal equations could be solved
+   */
+  const bool Fit(size_t first, size_t last, math::tPolynomial<Tdegree> &polynomial, double &residual_sum_of_squares) const;
+
+  /*!
+   * \brief Fit a polynomial (relative to Origin()) to all samples with x_min <= x <= x_max
+   */
+  const bool Fit(double x_min, double x_max, math::tPolynomial<Tdegree> &polynomial, double &residual_sum_of_squares) const;
+
+  /*!
+   * \brief The residual sum of squares of the least squares polynomial over [first, last) without solving for it
+   *
+   * \return The residual sum of squares or infinity if the range cannot be fitted
+   */
+  double ResidualSumOfSquares(size_t first, size_t last) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  enum { cNUMBER_OF_SUMS = 3 * Tdegree + 3, cROW_SIZE = cNUMBER_OF_SUMS + 1, cBLOCK_SIZE = 32 };
+
+  /*! The blocks of one level: level l + 1 holds the blocks of level l as its items */
+  struct tLevel
+  {
+    size_t samples_per_item;
+    std::vector<double> prefix_sums;   //!< One row per item: S(x^0..x^2n), S(x^0*y..x^n*y), S(y^2) from the start of its block to the item, and their center x
+    std::vector<double> suffix_sums;   //!< One row per item: the same from the item to the end of its block
+  };
+
+  bool compensated_summation;
+  double origin;
+  std::vector<double> x_values;
+  std::vector<double> y_values;
+  std::vector<tLevel> levels;
+
+  /*!
+   * \brief The center of the x-range of the samples of items [first_item, last_item] to which a row is relative
+   */
+  double RowCenter(size_t level, size_t first_item, size_t last_item) const;
+
+  void AddItemSums(size_t level, size_t item, double center, double(&sums)[cNUMBER_OF_SUMS]) const;
+
+  static void AddSample(double x, double y, double(&sums)[cNUMBER_OF_SUMS]);
+
+  /*!
+   * \brief Add the sums of a row to sums relative to offset
+   */
+  static void AddRow(const double *row, double offset, double(&sums)[cNUMBER_OF_SUMS]);
+
+  /*!
+   * \brief Add sums of t to sums of t + shift
+   */
+  static void AddShifted(const double *source, double shift, double(&sums)[cNUMBER_OF_SUMS]);
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tPolynomialMomentIndex";
+  }
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPolynomialMomentIndex.hpp"
+
+#endif
@@ -0,0 +1,436 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialMomentIndex.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialMomentIndex<Tdegree>::tPolynomialMomentIndex(bool compensated_summation)
+  : compensated_summation(compensated_summation),
+    origin(0)
+{}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tPolynomialMomentIndex<Tdegree>::tPolynomialMomentIndex(TIterator begin, TIterator end, bool compensated_summation)
+  : compensated_summation(compensated_summation),
+    origin(0)
+{
+  this->Build(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex Build
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tPolynomialMomentIndex<Tdegree>::Build(TIterator begin, TIterator end)
+{
+  std::vector<tSample> samples(begin, end);
+  std::stable_sort(samples.begin(), samples.end(), [](const tSample & a, const tSample & b)
+  {
+    return a.X() < b.X();
+  });
+
+  const size_t number_of_samples = samples.size();
+  this->x_values.resize(number_of_samples);
+  this->y_values.resize(number_of_samples);
+  this->origin = 0;
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    this->x_values[i] = samples[i].X();
+    this->y_values[i] = samples[i].Y();
+    this->origin += samples[i].X();
+  }
+  this->origin = number_of_samples > 0 ? this->origin / number_of_samples : 0;
+
+  this->levels.clear();
+  size_t number_of_items = number_of_samples;
+  size_t samples_per_item = 1;
+  while (number_of_items > 0)
+  {
+    const size_t level = this->levels.size();
+    const size_t number_of_blocks = (number_of_items + cBLOCK_SIZE - 1) / cBLOCK_SIZE;
+    this->levels.push_back(tLevel());
+    tLevel &current = this->levels.back();
+    current.samples_per_item = samples_per_item;
+    current.prefix_sums.resize(number_of_items * cROW_SIZE);
+    current.suffix_sums.resize(number_of_items * cROW_SIZE);
+
+    for (size_t block = 0; block < number_of_blocks; ++block)
+    {
+      const size_t first = block * cBLOCK_SIZE;
+      const size_t last = std::min<size_t>(first + cBLOCK_SIZE, number_of_items) - 1;
+
+      // forward and backward accumulation, each row relative to the center of its own range
+      for (int direction = 0; direction < 2; ++direction)
+      {
+        double sum[cNUMBER_OF_SUMS] = {};
+        double compensation[cNUMBER_OF_SUMS] = {};
+        double center = 0;
+        for (size_t k = 0; k <= last - first; ++k)
+        {
+          const size_t item = direction == 0 ? first + k : last - k;
+          const double new_center = direction == 0 ? this->RowCenter(level, first, item) : this->RowCenter(level, item, last);
+
+          double moved_sum[cNUMBER_OF_SUMS] = {};
+          double moved_compensation[cNUMBER_OF_SUMS] = {};
+          AddShifted(sum, center - new_center, moved_sum);
+          if (this->compensated_summation)
+          {
+            AddShifted(compensation, center - new_center, moved_compensation);
+          }
+          double terms[cNUMBER_OF_SUMS] = {};
+          this->AddItemSums(level, item, new_center, terms);
+
+          double *row = direction == 0 ? &current.prefix_sums[item * cROW_SIZE] : &current.suffix_sums[item * cROW_SIZE];
+          for (size_t j = 0; j < cNUMBER_OF_SUMS; ++j)
+          {
+            if (!this->compensated_summation)
+            {
+              sum[j] = moved_sum[j] + terms[j];
+            }
+            else
+            {
+              // Kahan summation: the exact sum is approximately sum - compensation
+              double term = terms[j] - moved_compensation[j];
+              sum[j] = moved_sum[j] + term;
+              compensation[j] = (sum[j] - moved_sum[j]) - term;
+            }
+            row[j] = sum[j];
+          }
+          row[cNUMBER_OF_SUMS] = new_center;
+          center = new_center;
+        }
+      }
+    }
+
+    number_of_items = number_of_blocks > 1 ? number_of_blocks : 0;
+    samples_per_item *= cBLOCK_SIZE;
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Built index over ", number_of_samples, " samples with ", this->levels.size(), " levels and origin ", this->origin);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex RowCenter
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialMomentIndex<Tdegree>::RowCenter(size_t level, size_t first_item, size_t last_item) const
+{
+  const size_t samples_per_item = this->levels[level].samples_per_item;
+  const size_t last_sample = std::min((last_item + 1) * samples_per_item, this->x_values.size()) - 1;
+  return 0.5 * (this->x_values[first_item * samples_per_item] + this->x_values[last_sample]);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex AddItemSums
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMomentIndex<Tdegree>::AddItemSums(size_t level, size_t item, double center, double(&sums)[cNUMBER_OF_SUMS]) const
+{
+  if (level == 0)
+  {
+    AddSample(this->x_values[item] - center, this->y_values[item], sums);
+    return;
+  }
+  // an item is a complete block of the level below, i.e. the suffix of its first item
+  const size_t first = item * cBLOCK_SIZE;
+  AddRow(&this->levels[level - 1].suffix_sums[first * cROW_SIZE], center, sums);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex AddSample
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMomentIndex<Tdegree>::AddSample(double x, double y, double(&sums)[cNUMBER_OF_SUMS])
+{
+  double x_power = 1;
+  for (size_t k = 0; k < 2 * Tdegree + 1; ++k)
+  {
+    sums[k] += x_power;
+    if (k < Tdegree + 1)
+    {
+      sums[2 * Tdegree + 1 + k] += x_power * y;
+    }
+    x_power *= x;
+  }
+  sums[cNUMBER_OF_SUMS - 1] += y * y;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex AddRow
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMomentIndex<Tdegree>::AddRow(const double *row, double offset, double(&sums)[cNUMBER_OF_SUMS])
+{
+  AddShifted(row, row[cNUMBER_OF_SUMS] - offset, sums);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex AddShifted
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMomentIndex<Tdegree>::AddShifted(const double *source, double shift, double(&sums)[cNUMBER_OF_SUMS])
+{
+  // S((t + shift)^k) = sum over j of C(k, j) * shift^(k - j) * S(t^j)
+  double shift_powers[2 * Tdegree + 1];
+  shift_powers[0] = 1;
+  for (size_t k = 1; k < 2 * Tdegree + 1; ++k)
+  {
+    shift_powers[k] = shift_powers[k - 1] * shift;
+  }
+
+  double binomials[2 * Tdegree + 1] = { 1 };
+  for (size_t k = 0; k < 2 * Tdegree + 1; ++k)
+  {
+    for (size_t j = k; j > 0; --j)
+    {
+      binomials[j] += binomials[j - 1];
+    }
+    double power_sum = 0;
+    for (size_t j = 0; j <= k; ++j)
+    {
+      power_sum += binomials[j] * shift_powers[k - j] * source[j];
+    }
+    sums[k] += power_sum;
+    if (k < Tdegree + 1)
+    {
+      double mixed_power_sum = 0;
+      for (size_t j = 0; j <= k; ++j)
+      {
+        mixed_power_sum += binomials[j] * shift_powers[k - j] * source[2 * Tdegree + 1 + j];
+      }
+      sums[2 * Tdegree + 1 + k] += mixed_power_sum;
+    }
+  }
+  sums[cNUMBER_OF_SUMS - 1] += source[cNUMBER_OF_SUMS - 1];
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex GetIndexRange
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMomentIndex<Tdegree>::GetIndexRange(double x_min, double x_max, size_t &first, size_t &last) const
+{
+  first = std::lower_bound(this->x_values.begin(), this->x_values.end(), x_min) - this->x_values.begin();
+  last = std::upper_bound(this->x_values.begin(), this->x_values.end(), x_max) - this->x_values.begin();
+  last = std::max(first, last);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex Moments
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+typename tPolynomialMomentIndex<Tdegree>::tMoments tPolynomialMomentIndex<Tdegree>::Moments(size_t first, size_t last, double &offset, double &scale) const
+{
+  assert(first <= last && last <= this->NumberOfSamples());
+
+  offset = 0;
+  scale = 1;
+  if (first == last)
+  {
+    return tMoments();
+  }
+  offset = 0.5 * (this->x_values[first] + this->x_values[last - 1]);
+  if (this->x_values[last - 1] > this->x_values[first])
+  {
+    scale = 0.5 * (this->x_values[last - 1] - this->x_values[first]);
+  }
+
+  double sums[cNUMBER_OF_SUMS] = {};
+  if (first / cBLOCK_SIZE == (last - 1) / cBLOCK_SIZE)
+  {
+    for (size_t i = first; i < last; ++i)
+    {
+      AddSample(this->x_values[i] - offset, this->y_values[i], sums);
+    }
+  }
+  else
+  {
+    // peel partial blocks off both ends and continue with the complete blocks in between one level up
+    size_t a = first;
+    size_t b = last;
+    for (size_t level = 0; a < b; ++level)
+    {
+      const tLevel &current = this->levels[level];
+      const size_t number_of_items = current.prefix_sums.size() / cROW_SIZE;
+      const size_t block_a = a / cBLOCK_SIZE;
+      const size_t block_b = (b - 1) / cBLOCK_SIZE;
+      const size_t block_start = block_a * cBLOCK_SIZE;
+      const size_t block_end = std::min<size_t>(block_start + cBLOCK_SIZE, number_of_items);
+      const bool a_at_start = a == block_start;
+      const bool b_at_end = b % cBLOCK_SIZE == 0 || b == number_of_items;
+
+      if (block_a == block_b)
+      {
+        if (a_at_start)
+        {
+          AddRow(&current.prefix_sums[(b - 1) * cROW_SIZE], offset, sums);
+        }
+        else if (b_at_end)
+        {
+          AddRow(&current.suffix_sums[a * cROW_SIZE], offset, sums);
+        }
+        else
+        {
+          // difference of two rows, taken from the side where less has to be subtracted
+          double subtrahend[cNUMBER_OF_SUMS] = {};
+          if (this->x_values[first] - this->RowCenter(level, block_start, block_start) < this->RowCenter(level, block_end - 1, block_end - 1) - this->x_values[last - 1])
+          {
+            AddRow(&current.prefix_sums[(b - 1) * cROW_SIZE], offset, sums);
+            AddRow(&current.prefix_sums[(a - 1) * cROW_SIZE], offset, subtrahend);
+          }
+          else
+          {
+            AddRow(&current.suffix_sums[a * cROW_SIZE], offset, sums);
+            AddRow(&current.suffix_sums[b * cROW_SIZE], offset, subtrahend);
+          }
+          for (size_t k = 0; k < cNUMBER_OF_SUMS; ++k)
+          {
+            sums[k] -= subtrahend[k];
+          }
+        }
+        break;
+      }
+
+      if (!a_at_start)
+      {
+        AddRow(&current.suffix_sums[a * cROW_SIZE], offset, sums);
+      }
+      if (!b_at_end)
+      {
+        AddRow(&current.prefix_sums[(b - 1) * cROW_SIZE], offset, sums);
+      }
+      a = a_at_start ? block_a : block_a + 1;
+      b = b_at_end ? block_b + 1 : block_b;
+    }
+  }
+
+  // scale to the half-width of the range
+  double power_sums[2 * Tdegree + 1];
+  double mixed_power_sums[Tdegree + 1];
+  double scale_power = 1;
+  for (size_t k = 0; k < 2 * Tdegree + 1; ++k)
+  {
+    power_sums[k] = sums[k] * scale_power;
+    if (k < Tdegree + 1)
+    {
+      mixed_power_sums[k] = sums[2 * Tdegree + 1 + k] * scale_power;
+    }
+    scale_power /= scale;
+  }
+  return tMoments(last - first, power_sums, mixed_power_sums, sums[cNUMBER_OF_SUMS - 1]);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex Fit
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tPolynomialMomentIndex<Tdegree>::Fit(size_t first, size_t last, math::tPolynomial<Tdegree> &polynomial, double &residual_sum_of_squares) const
+{
+  double offset, scale;
+  tMoments moments = this->Moments(first, last, offset, scale);
+
+  double l[Tdegree + 1][Tdegree + 1];
+  double z[Tdegree + 1];
+  if (moments.DecomposeNormalEquations(l, z) < Tdegree + 1)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Cannot fit polynomial to samples [", first, ", ", last, ").");
+    return false;
+  }
+
+  math::tVector < Tdegree + 1, double > coefficients;
+  tMoments::SolveDecomposedNormalEquations(l, z, Tdegree + 1, coefficients);
+  tLeastSquaresPolynomial<Tdegree>::ExpandNormalizedPolynomial(coefficients, offset - this->origin, scale, polynomial);
+  residual_sum_of_squares = moments.ResidualSumOfSquares(coefficients);
+
+  return true;
+}
+
+template <size_t Tdegree>
+const bool tPolynomialMomentIndex<Tdegree>::Fit(double x_min, double x_max, math::tPolynomial<Tdegree> &polynomial, double &residual_sum_of_squares) const
+{
+  size_t first, last;
+  this->GetIndexRange(x_min, x_max, first, last);
+  return this->Fit(first, last, polynomial, residual_sum_of_squares);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMomentIndex ResidualSumOfSquares
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialMomentIndex<Tdegree>::ResidualSumOfSquares(size_t first, size_t last) const
+{
+  double offset, scale;
+  return this->Moments(first, last, offset, scale).OptimalResidualSumOfSquares();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,222 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialMoments.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPolynomialMoments
+ *
+ * \b tPolynomialMoments
+ *
+ * The power sums that make up the normal equations of polynomial least
+ * squares regression, maintained incrementally.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPolynomialMoments_h__
+#define __rrlib__model_fitting__tPolynomialMoments_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Power sums of polynomial least squares regression
+/*! Holds n, S(xi^k) for k = 0..2n, S(xi^k*yi) for k = 0..n and S(yi^2)
+ *  of a sample set. Samples can be added and removed in O(Tdegree) and
+ *  two accumulators can be merged, so that the normal equations of a
+ *  changing sample set never have to be rebuilt from scratch. S(yi^2)
+ *  allows the residual sum of squares of a solution to be computed
+ *  without another pass over the samples.
+ */
+template <size_t Tdegree>
+class tPolynomialMoments
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  tPolynomialMoments();
+
+  template <typename TIterator>
+  tPolynomialMoments(TIterator begin, TIterator end);
+
+  /*!
+   * \brief Construct from precomputed sums (e.g. differences of prefix sums)
+   */
+  tPolynomialMoments(size_t number_of_samples, const double(&power_sums)[2 * Tdegree + 1], const double(&mixed_power_sums)[Tdegree + 1], double square_sum);
+
+  void Clear();
+
+  inline void Add(const math::tVec2d &sample)
+  {
+    this->Add(sample.X(), sample.Y(), 1.0);
+  }
+
+  /*!
+   * \brief Add a sample with the given weight for weighted least squares
+   *
+   * Samples with zero weight are ignored. The power sums then hold
+   * weighted sums and PowerSum(0) is the total weight.
+   */
+  inline void Add(const math::tVec2d &sample, double weight)
+  {
+    assert(weight >= 0);
+    if (weight > 0)
+    {
+      this->Add(sample.X(), sample.Y(), weight);
+    }
+  }
+
+  inline void Remove(const math::tVec2d &sample)
+  {
+    this->Add(sample.X(), sample.Y(), -1.0);
+  }
+
+  template <typename TIterator>
+  void Add(TIterator begin, TIterator end);
+
+  tPolynomialMoments &operator += (const tPolynomialMoments &other);
+
+  tPolynomialMoments &operator -= (const tPolynomialMoments &other);
+
+  inline size_t NumberOfSamples() const
+  {
+    return this->number_of_samples;
+  }
+
+  /*!
+   * \brief S(xi^k) for k = 0..2*Tdegree
+   */
+  inline double PowerSum(size_t k) const
+  {
+    assert(k < 2 * Tdegree + 1);
+    return this->power_sums[k];
+  }
+
+  /*!
+   * \brief S(xi^k*yi) for k = 0..Tdegree
+   */
+  inline double MixedPowerSum(size_t k) const
+  {
+    assert(k < Tdegree + 1);
+    return this->mixed_power_sums[k];
+  }
+
+  /*!
+   * \brief S(yi^2)
+   */
+  inline double SquareSum() const
+  {
+    return this->square_sum;
+  }
+
+  /*!
+   * \brief Get the residual sum of squares of the polynomial with the given coefficients
+   */
+  double ResidualSumOfSquares(const math::tVector < Tdegree + 1, double > &coefficients) const;
+
+  /*!
+   * \brief Cholesky-decompose the normal matrix and forward-substitute the right-hand side
+   *
+   * The leading (d+1)x(d+1) block of l and the first d+1 entries of z are
+   * the decomposition of the normal equations of degree d, so one call
+   * serves all degrees up to Tdegree. S(yi^2) minus the sum of the first
+   * d+1 squared entries of z is the residual sum of squares of the
+   * least squares polynomial of degree d.
+   *
+   * \param l   The lower triangular factor
+   * \param z   The solution of l * z = S(xi^k*yi)
+   *
+   * \return The number of leading rows that could be decomposed (i.e. one more than the highest solvable degree)
+   */
+  size_t DecomposeNormalEquations(double(&l)[Tdegree + 1][Tdegree + 1], double(&z)[Tdegree + 1]) const;
+
+  /*!
+   * \brief The residual sum of squares of the least squares polynomial of these power sums without solving for it
+   *
+   * \return The residual sum of squares or infinity if the normal equations cannot be solved
+   */
+  double OptimalResidualSumOfSquares() const;
+
+  /*!
+   * \brief Back-substitute a decomposition from DecomposeNormalEquations
+   *
+   * \param size           The number of coefficients to solve for (degree + 1); the remaining ones are set to zero
+   * \param coefficients   The solution
+   */
+  static void SolveDecomposedNormalEquations(const double(&l)[Tdegree + 1][Tdegree + 1], const double(&z)[Tdegree + 1], size_t size,
+      math::tVector < Tdegree + 1, double > &coefficients);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  size_t number_of_samples;
+  double power_sums[2 * Tdegree + 1];
+  double mixed_power_sums[Tdegree + 1];
+  double square_sum;
+
+  void Add(double x, double y, double weight);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPolynomialMoments.hpp"
+
+#endif
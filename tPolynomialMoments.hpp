@@ -0,0 +1,291 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialMoments.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPolynomialMoments constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialMoments<Tdegree>::tPolynomialMoments()
+{
+  this->Clear();
+}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tPolynomialMoments<Tdegree>::tPolynomialMoments(TIterator begin, TIterator end)
+{
+  this->Clear();
+  this->Add(begin, end);
+}
+
+template <size_t Tdegree>
+tPolynomialMoments<Tdegree>::tPolynomialMoments(size_t number_of_samples, const double(&power_sums)[2 * Tdegree + 1], const double(&mixed_power_sums)[Tdegree + 1], double square_sum)
+  : number_of_samples(number_of_samples),
+    square_sum(square_sum)
+{
+  std::copy(power_sums, power_sums + 2 * Tdegree + 1, this->power_sums);
+  std::copy(mixed_power_sums, mixed_power_sums + Tdegree + 1, this->mixed_power_sums);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments Clear
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMoments<Tdegree>::Clear()
+{
+  this->number_of_samples = 0;
+  std::fill(this->power_sums, this->power_sums + 2 * Tdegree + 1, 0.0);
+  std::fill(this->mixed_power_sums, this->mixed_power_sums + Tdegree + 1, 0.0);
+  this->square_sum = 0;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments Add
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tPolynomialMoments<Tdegree>::Add(TIterator begin, TIterator end)
+{
+  for (TIterator it = begin; it != end; ++it)
+  {
+    this->Add(it->X(), it->Y(), 1.0);
+  }
+}
+
+template <size_t Tdegree>
+void tPolynomialMoments<Tdegree>::Add(double x, double y, double weight)
+{
+  assert(weight > 0 || this->number_of_samples > 0);
+  this->number_of_samples += weight > 0 ? 1 : -1;
+
+  double x_power = weight;
+  for (size_t k = 0; k < Tdegree + 1; ++k)
+  {
+    this->power_sums[k] += x_power;
+    this->mixed_power_sums[k] += x_power * y;
+    x_power *= x;
+  }
+  for (size_t k = Tdegree + 1; k < 2 * Tdegree + 1; ++k)
+  {
+    this->power_sums[k] += x_power;
+    x_power *= x;
+  }
+  this->square_sum += weight * y * y;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments operator +=
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialMoments<Tdegree> &tPolynomialMoments<Tdegree>::operator += (const tPolynomialMoments &other)
+{
+  this->number_of_samples += other.number_of_samples;
+  for (size_t k = 0; k < 2 * Tdegree + 1; ++k)
+  {
+    this->power_sums[k] += other.power_sums[k];
+  }
+  for (size_t k = 0; k < Tdegree + 1; ++k)
+  {
+    this->mixed_power_sums[k] += other.mixed_power_sums[k];
+  }
+  this->square_sum += other.square_sum;
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments operator -=
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialMoments<Tdegree> &tPolynomialMoments<Tdegree>::operator -= (const tPolynomialMoments &other)
+{
+  assert(this->number_of_samples >= other.number_of_samples);
+  this->number_of_samples -= other.number_of_samples;
+  for (size_t k = 0; k < 2 * Tdegree + 1; ++k)
+  {
+    this->power_sums[k] -= other.power_sums[k];
+  }
+  for (size_t k = 0; k < Tdegree + 1; ++k)
+  {
+    this->mixed_power_sums[k] -= other.mixed_power_sums[k];
+  }
+  this->square_sum -= other.square_sum;
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments ResidualSumOfSquares
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialMoments<Tdegree>::ResidualSumOfSquares(const math::tVector < Tdegree + 1, double > &coefficients) const
+{
+  /*
+   * S((yi - c^T*xi)^2) = S(yi^2) - 2 * c^T * S(xi*yi) + c^T * S(xi*xi^T) * c
+   */
+  double result = this->square_sum;
+  for (size_t row = 0; row < Tdegree + 1; ++row)
+  {
+    double a_c = 0;
+    for (size_t column = 0; column < Tdegree + 1; ++column)
+    {
+      a_c += this->power_sums[row + column] * coefficients[column];
+    }
+    result += coefficients[row] * (a_c - 2 * this->mixed_power_sums[row]);
+  }
+  return std::max(result, 0.0);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments DecomposeNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+size_t tPolynomialMoments<Tdegree>::DecomposeNormalEquations(double(&l)[Tdegree + 1][Tdegree + 1], double(&z)[Tdegree + 1]) const
+{
+  /*
+   * The normal matrix is a Hankel matrix of the power sums, so we
+   * decompose it into L*L^T without building it explicitly.
+   */
+  for (size_t row = 0; row < Tdegree + 1; ++row)
+  {
+    for (size_t column = 0; column <= row; ++column)
+    {
+      double sum = this->power_sums[row + column];
+      for (size_t k = 0; k < column; ++k)
+      {
+        sum -= l[row][k] * l[column][k];
+      }
+      if (row == column)
+      {
+        if (!(sum > 0))
+        {
+          return row;
+        }
+        l[row][row] = std::sqrt(sum);
+      }
+      else
+      {
+        l[row][column] = sum / l[column][column];
+      }
+    }
+
+    double sum = this->mixed_power_sums[row];
+    for (size_t k = 0; k < row; ++k)
+    {
+      sum -= l[row][k] * z[k];
+    }
+    z[row] = sum / l[row][row];
+  }
+  return Tdegree + 1;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments OptimalResidualSumOfSquares
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialMoments<Tdegree>::OptimalResidualSumOfSquares() const
+{
+  double l[Tdegree + 1][Tdegree + 1];
+  double z[Tdegree + 1];
+  if (this->DecomposeNormalEquations(l, z) < Tdegree + 1)
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  double residual_sum_of_squares = this->square_sum;
+  for (size_t k = 0; k < Tdegree + 1; ++k)
+  {
+    residual_sum_of_squares -= z[k] * z[k];
+  }
+  return std::max(residual_sum_of_squares, 0.0);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialMoments SolveDecomposedNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialMoments<Tdegree>::SolveDecomposedNormalEquations(const double(&l)[Tdegree + 1][Tdegree + 1], const double(&z)[Tdegree + 1], size_t size,
+    math::tVector < Tdegree + 1, double > &coefficients)
+{
+  assert(size <= Tdegree + 1);
+  for (size_t row = Tdegree + 1; row-- > size;)
+  {
+    coefficients[row] = 0;
+  }
+  for (size_t row = size; row-- > 0;)
+  {
+    double sum = z[row];
+    for (size_t k = row + 1; k < size; ++k)
+    {
+      sum -= l[k][row] * coefficients[k];
+    }
+    coefficients[row] = sum / l[row][row];
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,216 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialSurfaceMoments.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tPolynomialSurfaceMoments
+ *
+ * \b tPolynomialSurfaceMoments
+ *
+ * Accumulated power sums for least squares fitting of bivariate
+ * polynomial surfaces z = f(x, y).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tPolynomialSurfaceMoments_h__
+#define __rrlib__model_fitting__tPolynomialSurfaceMoments_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstddef>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Power sums of bivariate polynomial least squares regression
+/*! Holds n, S(xi^a*yi^b) for a + b <= 2n, S(xi^a*yi^b*zi) for a + b <= n
+ *  and S(zi^2) of a sample set of points (x, y, z). These determine the
+ *  normal equations of the surface z = f(x, y) with all monomials
+ *  x^a*y^b of total degree a + b <= Tdegree. Like tPolynomialMoments,
+ *  samples can be added and removed in constant time and accumulators can
+ *  be merged, e.g. to fit overlapping patches of an elevation map.
+ *
+ *  Monomials are numbered in graded order: 1, x, y, x^2, x*y, y^2, ...
+ */
+template <size_t Tdegree>
+class tPolynomialSurfaceMoments
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  enum { cNUMBER_OF_TERMS = (Tdegree + 1) * (Tdegree + 2) / 2 };
+
+  tPolynomialSurfaceMoments();
+
+  template <typename TIterator>
+  tPolynomialSurfaceMoments(TIterator begin, TIterator end);
+
+  void Clear();
+
+  inline void Add(const math::tVec3d &sample)
+  {
+    this->Add(sample.X(), sample.Y(), sample.Z(), 1.0);
+  }
+
+  /*!
+   * \brief Add a sample with the given weight for weighted least squares
+   *
+   * Samples with zero weight are ignored.
+   */
+  inline void Add(const math::tVec3d &sample, double weight)
+  {
+    assert(weight >= 0);
+    if (weight > 0)
+    {
+      this->Add(sample.X(), sample.Y(), sample.Z(), weight);
+    }
+  }
+
+  inline void Remove(const math::tVec3d &sample)
+  {
+    this->Add(sample.X(), sample.Y(), sample.Z(), -1.0);
+  }
+
+  template <typename TIterator>
+  void Add(TIterator begin, TIterator end);
+
+  tPolynomialSurfaceMoments &operator += (const tPolynomialSurfaceMoments &other);
+
+  tPolynomialSurfaceMoments &operator -= (const tPolynomialSurfaceMoments &other);
+
+  inline size_t NumberOfSamples() const
+  {
+    return this->number_of_samples;
+  }
+
+  /*!
+   * \brief S(xi^a*yi^b) for a + b <= 2*Tdegree
+   */
+  inline double PowerSum(size_t a, size_t b) const
+  {
+    assert(a + b < 2 * Tdegree + 1);
+    return this->power_sums[a][b];
+  }
+
+  /*!
+   * \brief S(xi^a*yi^b*zi) for a + b <= Tdegree
+   */
+  inline double MixedPowerSum(size_t a, size_t b) const
+  {
+    assert(a + b < Tdegree + 1);
+    return this->mixed_power_sums[a][b];
+  }
+
+  /*!
+   * \brief S(zi^2)
+   */
+  inline double SquareSum() const
+  {
+    return this->square_sum;
+  }
+
+  /*!
+   * \brief The exponents of x and y of the monomial with the given number
+   */
+  static void GetExponents(size_t term, size_t &x_exponent, size_t &y_exponent);
+
+  /*!
+   * \brief Get the residual sum of squares of the surface with the given coefficients
+   */
+  double ResidualSumOfSquares(const double(&coefficients)[cNUMBER_OF_TERMS]) const;
+
+  /*!
+   * \brief Cholesky-decompose the normal matrix and forward-substitute the right-hand side
+   *
+   * \param l   The lower triangular factor
+   * \param z   The solution of l * z = S(xi^a*yi^b*zi)
+   *
+   * \return Whether the normal matrix was positive definite
+   */
+  const bool DecomposeNormalEquations(double(&l)[cNUMBER_OF_TERMS][cNUMBER_OF_TERMS], double(&z)[cNUMBER_OF_TERMS]) const;
+
+  /*!
+   * \brief The residual sum of squares of the least squares surface of these power sums without solving for it
+   *
+   * \return The residual sum of squares or infinity if the normal equations cannot be solved
+   */
+  double OptimalResidualSumOfSquares() const;
+
+  /*!
+   * \brief Back-substitute a decomposition from DecomposeNormalEquations
+   */
+  static void SolveDecomposedNormalEquations(const double(&l)[cNUMBER_OF_TERMS][cNUMBER_OF_TERMS], const double(&z)[cNUMBER_OF_TERMS],
+      double(&coefficients)[cNUMBER_OF_TERMS]);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  size_t number_of_samples;
+  double power_sums[2 * Tdegree + 1][2 * Tdegree + 1];
+  double mixed_power_sums[Tdegree + 1][Tdegree + 1];
+  double square_sum;
+
+  void Add(double x, double y, double z, double weight);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tPolynomialSurfaceMoments.hpp"
+
+#endif
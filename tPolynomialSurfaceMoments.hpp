@@ -0,0 +1,322 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tPolynomialSurfaceMoments.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialSurfaceMoments<Tdegree>::tPolynomialSurfaceMoments()
+{
+  this->Clear();
+}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tPolynomialSurfaceMoments<Tdegree>::tPolynomialSurfaceMoments(TIterator begin, TIterator end)
+{
+  this->Clear();
+  this->Add(begin, end);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments Clear
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialSurfaceMoments<Tdegree>::Clear()
+{
+  this->number_of_samples = 0;
+  std::fill(&this->power_sums[0][0], &this->power_sums[0][0] + (2 * Tdegree + 1) * (2 * Tdegree + 1), 0.0);
+  std::fill(&this->mixed_power_sums[0][0], &this->mixed_power_sums[0][0] + (Tdegree + 1) * (Tdegree + 1), 0.0);
+  this->square_sum = 0;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments Add
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+template <typename TIterator>
+void tPolynomialSurfaceMoments<Tdegree>::Add(TIterator begin, TIterator end)
+{
+  for (TIterator it = begin; it != end; ++it)
+  {
+    this->Add(it->X(), it->Y(), it->Z(), 1.0);
+  }
+}
+
+template <size_t Tdegree>
+void tPolynomialSurfaceMoments<Tdegree>::Add(double x, double y, double z, double weight)
+{
+  assert(weight > 0 || this->number_of_samples > 0);
+  this->number_of_samples += weight > 0 ? 1 : -1;
+
+  double x_powers[2 * Tdegree + 1];
+  double y_powers[2 * Tdegree + 1];
+  x_powers[0] = weight;
+  y_powers[0] = 1;
+  for (size_t k = 1; k < 2 * Tdegree + 1; ++k)
+  {
+    x_powers[k] = x_powers[k - 1] * x;
+    y_powers[k] = y_powers[k - 1] * y;
+  }
+
+  for (size_t a = 0; a < 2 * Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; a + b < 2 * Tdegree + 1; ++b)
+    {
+      this->power_sums[a][b] += x_powers[a] * y_powers[b];
+    }
+  }
+  for (size_t a = 0; a < Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; a + b < Tdegree + 1; ++b)
+    {
+      this->mixed_power_sums[a][b] += x_powers[a] * y_powers[b] * z;
+    }
+  }
+  this->square_sum += weight * z * z;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments operator +=
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialSurfaceMoments<Tdegree> &tPolynomialSurfaceMoments<Tdegree>::operator += (const tPolynomialSurfaceMoments &other)
+{
+  this->number_of_samples += other.number_of_samples;
+  for (size_t a = 0; a < 2 * Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; b < 2 * Tdegree + 1; ++b)
+    {
+      this->power_sums[a][b] += other.power_sums[a][b];
+    }
+  }
+  for (size_t a = 0; a < Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; b < Tdegree + 1; ++b)
+    {
+      this->mixed_power_sums[a][b] += other.mixed_power_sums[a][b];
+    }
+  }
+  this->square_sum += other.square_sum;
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments operator -=
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tPolynomialSurfaceMoments<Tdegree> &tPolynomialSurfaceMoments<Tdegree>::operator -= (const tPolynomialSurfaceMoments &other)
+{
+  assert(this->number_of_samples >= other.number_of_samples);
+  this->number_of_samples -= other.number_of_samples;
+  for (size_t a = 0; a < 2 * Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; b < 2 * Tdegree + 1; ++b)
+    {
+      this->power_sums[a][b] -= other.power_sums[a][b];
+    }
+  }
+  for (size_t a = 0; a < Tdegree + 1; ++a)
+  {
+    for (size_t b = 0; b < Tdegree + 1; ++b)
+    {
+      this->mixed_power_sums[a][b] -= other.mixed_power_sums[a][b];
+    }
+  }
+  this->square_sum -= other.square_sum;
+  return *this;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments GetExponents
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialSurfaceMoments<Tdegree>::GetExponents(size_t term, size_t &x_exponent, size_t &y_exponent)
+{
+  assert(term < cNUMBER_OF_TERMS);
+  size_t total_degree = 0;
+  while (term > total_degree)
+  {
+    term -= total_degree + 1;
+    ++total_degree;
+  }
+  y_exponent = term;
+  x_exponent = total_degree - term;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments ResidualSumOfSquares
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialSurfaceMoments<Tdegree>::ResidualSumOfSquares(const double(&coefficients)[cNUMBER_OF_TERMS]) const
+{
+  // S((zi - f(xi, yi))^2) = S(zi^2) - 2 * c^T * b + c^T * A * c
+  double residual_sum_of_squares = this->square_sum;
+  for (size_t i = 0; i < cNUMBER_OF_TERMS; ++i)
+  {
+    size_t ai, bi;
+    GetExponents(i, ai, bi);
+    residual_sum_of_squares -= 2 * coefficients[i] * this->mixed_power_sums[ai][bi];
+    for (size_t j = 0; j < cNUMBER_OF_TERMS; ++j)
+    {
+      size_t aj, bj;
+      GetExponents(j, aj, bj);
+      residual_sum_of_squares += coefficients[i] * coefficients[j] * this->power_sums[ai + aj][bi + bj];
+    }
+  }
+  return std::max(residual_sum_of_squares, 0.0);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments DecomposeNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tPolynomialSurfaceMoments<Tdegree>::DecomposeNormalEquations(double(&l)[cNUMBER_OF_TERMS][cNUMBER_OF_TERMS], double(&z)[cNUMBER_OF_TERMS]) const
+{
+  size_t x_exponents[cNUMBER_OF_TERMS];
+  size_t y_exponents[cNUMBER_OF_TERMS];
+  for (size_t i = 0; i < cNUMBER_OF_TERMS; ++i)
+  {
+    GetExponents(i, x_exponents[i], y_exponents[i]);
+  }
+
+  for (size_t row = 0; row < cNUMBER_OF_TERMS; ++row)
+  {
+    for (size_t column = 0; column <= row; ++column)
+    {
+      double sum = this->power_sums[x_exponents[row] + x_exponents[column]][y_exponents[row] + y_exponents[column]];
+      for (size_t k = 0; k < column; ++k)
+      {
+        sum -= l[row][k] * l[column][k];
+      }
+      if (row == column)
+      {
+        if (!(sum > 0))
+        {
+          return false;
+        }
+        l[row][row] = std::sqrt(sum);
+      }
+      else
+      {
+        l[row][column] = sum / l[column][column];
+      }
+    }
+
+    double sum = this->mixed_power_sums[x_exponents[row]][y_exponents[row]];
+    for (size_t k = 0; k < row; ++k)
+    {
+      sum -= l[row][k] * z[k];
+    }
+    z[row] = sum / l[row][row];
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments OptimalResidualSumOfSquares
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+double tPolynomialSurfaceMoments<Tdegree>::OptimalResidualSumOfSquares() const
+{
+  double l[cNUMBER_OF_TERMS][cNUMBER_OF_TERMS];
+  double z[cNUMBER_OF_TERMS];
+  if (!this->DecomposeNormalEquations(l, z))
+  {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  double residual_sum_of_squares = this->square_sum;
+  for (size_t k = 0; k < cNUMBER_OF_TERMS; ++k)
+  {
+    residual_sum_of_squares -= z[k] * z[k];
+  }
+  return std::max(residual_sum_of_squares, 0.0);
+}
+
+//----------------------------------------------------------------------
+// tPolynomialSurfaceMoments SolveDecomposedNormalEquations
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tPolynomialSurfaceMoments<Tdegree>::SolveDecomposedNormalEquations(const double(&l)[cNUMBER_OF_TERMS][cNUMBER_OF_TERMS], const double(&z)[cNUMBER_OF_TERMS],
+    double(&coefficients)[cNUMBER_OF_TERMS])
+{
+  for (size_t row = cNUMBER_OF_TERMS; row-- > 0;)
+  {
+    double sum = z[row];
+    for (size_t k = row + 1; k < cNUMBER_OF_TERMS; ++k)
+    {
+      sum -= l[k][row] * coefficients[k];
+    }
+    coefficients[row] = sum / l[row][row];
+  }
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
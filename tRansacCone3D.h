@@ -0,0 +1,190 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacCone3D.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRansacCone3D
+ *
+ * \b tRansacCone3D
+ *
+ * A few words for tRansacCone3D
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tRansacCone3D_h__
+#define __rrlib__model_fitting__tRansacCone3D_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+
+#include "rrlib/math/tAngle.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tRansacModel.h"
+#include "rrlib/model_fitting/tOrientedPointShape.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! RANSAC cone model for oriented points
+/*! Three oriented points determine a cone: the apex is the intersection
+    of their tangent planes, and the unit vectors from the apex to the
+    points lie on a circle around the axis. A sample is an inlier if its
+    distance to the surface is small and its normal encloses at most the
+    given angle with the surface normal, regardless of its sign.
+
+    The refit intersects all tangent planes in the least squares sense and
+    takes the axis from the plane through the unit vectors from the apex.
+*/
+template <typename TElement = double>
+class tRansacCone3D : public model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement>, public tOrientedPointShape<TElement>
+{
+
+  typedef model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement> tRansacModel;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tOrientedPoint3D<TElement> tSample;
+  typedef typename tSample::tPoint tPoint;
+
+  explicit tRansacCone3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization = false);
+
+  template <typename TIterator>
+  tRansacCone3D(TIterator begin, TIterator end, math::tAngleRadUnsigned max_normal_angle_distance,
+                unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
+                bool local_optimization = false)
+    : tRansacModel(local_optimization),
+      axis_direction(0, 0, 1),
+      sine(0),
+      cosine(1)
+  {
+    this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+    this->Initialize(std::distance(begin, end));
+    this->AddSamples(begin, end);
+    if (!this->DoRANSAC(max_iterations, satisfactory_support_ratio, max_error))
+    {
+      throw std::runtime_error("Failed to fit RANSAC model during construction!");
+    }
+  }
+
+  virtual tRansacCone3D *Clone() const
+  {
+    return new tRansacCone3D(*this);
+  }
+
+  const size_t MinimalSetSize() const
+  {
+    return 3;
+  }
+
+  inline const tPoint &Apex() const
+  {
+    return this->apex;
+  }
+
+  /*!
+   * \brief The axis, pointing from the apex into the cone
+   */
+  inline const tPoint &AxisDirection() const
+  {
+    return this->axis_direction;
+  }
+
+  /*!
+   * \brief The angle between the axis and the surface in radians
+   */
+  inline TElement HalfAngle() const
+  {
+    return std::atan2(this->sine, this->cosine);
+  }
+
+  /*!
+   * \brief The maximal angle between the normals of inliers and the surface normal
+   */
+  void SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance);
+
+  virtual const bool FitToMinimalSamples(const std::vector<tSample> &samples);
+  virtual const bool FitToSamples(const std::vector<tSample> &samples);
+  virtual const TElement GetSampleError(const tSample &sample) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tPoint apex;
+  tPoint axis_direction;
+  TElement sine;
+  TElement cosine;
+
+  TElement min_normal_cosine;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tRansacCone3D";
+  }
+
+  const bool FitToOrientedPoints(const tSample &a, const tSample &b, const tSample &c);
+  const bool SetAxisAndAngle(const std::vector<tPoint> &directions);
+  const bool CheckNormalAgreement(const tSample &sample) const;
+
+  virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tRansacCone3D.hpp"
+
+#endif
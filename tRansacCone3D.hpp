@@ -0,0 +1,322 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacCone3D.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/gaussian_elimination.h"
+#include "rrlib/model_fitting/tPlaneMoments.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRansacCone3D constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tRansacCone3D<TElement>::tRansacCone3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization)
+  : tRansacModel(local_optimization),
+    axis_direction(0, 0, 1),
+    sine(0),
+    cosine(1)
+{
+  this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D SetMaxNormalAngleDistance
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacCone3D<TElement>::SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance)
+{
+  this->min_normal_cosine = std::cos(static_cast<double>(max_angle_distance));
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D FitToMinimalSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  return this->FitToOrientedPoints(this->Samples()[sample_index_set[0]], this->Samples()[sample_index_set[1]], this->Samples()[sample_index_set[2]]);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D FitToMinimalSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::FitToMinimalSamples(const std::vector<tSample> &samples)
+{
+  assert(samples.size() >= 3);
+  return this->FitToOrientedPoints(samples[0], samples[1], samples[2]);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D FitToSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  std::vector<tSample> samples;
+  samples.reserve(sample_index_set.size());
+  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  {
+    samples.push_back(this->Samples()[*it]);
+  }
+  return this->FitToSamples(samples);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D FitToOrientedPoints
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::FitToOrientedPoints(const tSample &a, const tSample &b, const tSample &c)
+{
+  const tSample *samples[3] = { &a, &b, &c };
+
+  // the apex lies on all tangent planes
+  double m[3][3];
+  double apex[3];
+  for (size_t i = 0; i < 3; ++i)
+  {
+    m[i][0] = samples[i]->normal.X();
+    m[i][1] = samples[i]->normal.Y();
+    m[i][2] = samples[i]->normal.Z();
+    apex[i] = samples[i]->normal * (samples[i]->point - a.point);
+  }
+  if (!SolveLinearSystem(m, apex, 1E-6))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Tangent planes do not intersect in a point.");
+    return false;
+  }
+  this->apex = a.point + tPoint(apex[0], apex[1], apex[2]);
+
+  std::vector<tPoint> directions;
+  directions.reserve(3);
+  for (size_t i = 0; i < 3; ++i)
+  {
+    tPoint direction = samples[i]->point - this->apex;
+    if (direction.IsZero())
+    {
+      return false;
+    }
+    directions.push_back(direction.Normalized());
+  }
+  tPoint axis = math::CrossMul(tPoint(directions[1] - directions[0]), tPoint(directions[2] - directions[0]));
+  if (axis.IsZero())
+  {
+    return false;
+  }
+  this->axis_direction = axis.Normalized();
+  if (!this->SetAxisAndAngle(directions))
+  {
+    return false;
+  }
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Cone: (", this->apex, ", ", this->axis_direction, ", ", this->HalfAngle(), ")");
+
+  return this->CheckNormalAgreement(a) && this->CheckNormalAgreement(b) && this->CheckNormalAgreement(c);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D FitToSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::FitToSamples(const std::vector<tSample> &samples)
+{
+  if (samples.size() < 3)
+  {
+    return false;
+  }
+
+  // least squares intersection of the tangent planes relative to the first point
+  const tPoint &reference = samples.front().point;
+  double m[3][3] = {};
+  double apex[3] = {};
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    double square_length = it->normal * it->normal;
+    if (square_length == 0)
+    {
+      continue;
+    }
+    double normal[3] = { it->normal.X(), it->normal.Y(), it->normal.Z() };
+    double offset = it->normal * (it->point - reference);
+    for (size_t i = 0; i < 3; ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        m[i][j] += normal[i] * normal[j] / square_length;
+      }
+      apex[i] += normal[i] * offset / square_length;
+    }
+  }
+  if (!SolveLinearSystem(m, apex, 1E-6))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine an apex!");
+    return false;
+  }
+  tPoint new_apex = reference + tPoint(apex[0], apex[1], apex[2]);
+
+  std::vector<tPoint> directions;
+  directions.reserve(samples.size());
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    tPoint direction = it->point - new_apex;
+    if (!direction.IsZero())
+    {
+      directions.push_back(direction.Normalized());
+    }
+  }
+
+  // the unit directions lie on a circle, so the axis is the normal of their plane
+  tPlaneMoments<TElement> moments(directions.begin(), directions.end());
+  geometry::tPlane<3, TElement> plane;
+  plane.Set(tPoint(0, 0, 0), this->axis_direction);
+  if (!moments.GetPlane(plane))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine an axis!");
+    return false;
+  }
+  tPoint old_axis_direction = this->axis_direction;
+  this->axis_direction = plane.Normal();
+  if (!this->SetAxisAndAngle(directions))
+  {
+    this->axis_direction = old_axis_direction;
+    return false;
+  }
+  this->apex = new_apex;
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->apex, ", ", this->axis_direction, ", ", this->HalfAngle(), ")");
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D SetAxisAndAngle
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::SetAxisAndAngle(const std::vector<tPoint> &directions)
+{
+  double cosine = 0;
+  for (typename std::vector<tPoint>::const_iterator it = directions.begin(); it != directions.end(); ++it)
+  {
+    cosine += *it * this->axis_direction;
+  }
+  cosine /= directions.size();
+  if (cosine < 0)
+  {
+    this->axis_direction = -this->axis_direction;
+    cosine = -cosine;
+  }
+
+  // nearly flat cones are planes and nearly parallel ones are cylinders
+  if (cosine < 1E-3 || cosine > 1 - 1E-6)
+  {
+    return false;
+  }
+  this->cosine = cosine;
+  this->sine = std::sqrt(1 - cosine * cosine);
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D GetSampleError
+//----------------------------------------------------------------------
+template <typename TElement>
+const TElement tRansacCone3D<TElement>::GetSampleError(const tSample &sample) const
+{
+  if (!this->CheckNormalAgreement(sample))
+  {
+    return std::numeric_limits<TElement>::infinity();
+  }
+
+  // distance to the generating ray in the half plane through the axis and the point
+  tPoint v = sample.point - this->apex;
+  TElement along = v * this->axis_direction;
+  TElement across = (v - along * this->axis_direction).Length();
+  if (across * this->sine + along * this->cosine < 0)
+  {
+    return v.Length();
+  }
+  return std::fabs(across * this->cosine - along * this->sine);
+}
+
+//----------------------------------------------------------------------
+// tRansacCone3D CheckNormalAgreement
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCone3D<TElement>::CheckNormalAgreement(const tSample &sample) const
+{
+  tPoint v = sample.point - this->apex;
+  tPoint radial = v - (v * this->axis_direction) * this->axis_direction;
+  if (radial.IsZero() || sample.normal.IsZero())
+  {
+    return false;
+  }
+  tPoint surface_normal = this->cosine * radial.Normalized() - this->sine * this->axis_direction;
+  return std::fabs(sample.normal * surface_normal) >= this->min_normal_cosine * sample.normal.Length();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -0,0 +1,286 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacCylinder3D.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/gaussian_elimination.h"
+#include "rrlib/model_fitting/symmetric_eigen_decomposition_3x3.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tRansacCylinder3D<TElement>::tRansacCylinder3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization)
+  : tRansacModel(local_optimization),
+    axis_direction(0, 0, 1),
+    radius(0)
+{
+  this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D SetMaxNormalAngleDistance
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacCylinder3D<TElement>::SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance)
+{
+  this->min_normal_cosine = std::cos(static_cast<double>(max_angle_distance));
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D FitToMinimalSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  return this->FitToOrientedPoints(this->Samples()[sample_index_set[0]], this->Samples()[sample_index_set[1]]);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D FitToMinimalSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::FitToMinimalSamples(const std::vector<tSample> &samples)
+{
+  assert(samples.size() >= 2);
+  return this->FitToOrientedPoints(samples[0], samples[1]);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D FitToSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  std::vector<tSample> samples;
+  samples.reserve(sample_index_set.size());
+  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  {
+    samples.push_back(this->Samples()[*it]);
+  }
+  return this->FitToSamples(samples);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D FitToOrientedPoints
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::FitToOrientedPoints(const tSample &a, const tSample &b)
+{
+  tPoint axis = math::CrossMul(a.normal.Normalized(), b.normal.Normalized());
+  if (axis.Length() < 1E-6)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Normals are parallel.");
+    return false;
+  }
+  this->axis_direction = axis.Normalized();
+
+  // both normal lines are perpendicular to the axis, so they intersect after moving b into the cross section of a
+  tPoint b_point = b.point - ((b.point - a.point) * this->axis_direction) * this->axis_direction;
+  tPoint w = a.point - b_point;
+  double aa = a.normal * a.normal;
+  double ab = a.normal * b.normal;
+  double bb = b.normal * b.normal;
+  double aw = a.normal * w;
+  double bw = b.normal * w;
+  double denominator = aa * bb - ab * ab;
+  double s = (ab * bw - bb * aw) / denominator;
+  double t = (aa * bw - ab * aw) / denominator;
+
+  this->axis_point = 0.5 * (a.point + s * a.normal + b_point + t * b.normal);
+  this->radius = 0.5 * ((a.point - this->axis_point).Length() + (b_point - this->axis_point).Length());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Cylinder: (", this->axis_point, ", ", this->axis_direction, ", ", this->radius, ")");
+
+  return this->radius > 0 && this->CheckNormalAgreement(a) && this->CheckNormalAgreement(b);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D FitToSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::FitToSamples(const std::vector<tSample> &samples)
+{
+  if (samples.size() < 3)
+  {
+    return false;
+  }
+
+  // the normals of a cylinder are perpendicular to its axis
+  double normal_scatter[3][3] = {};
+  double mean[3] = { 0, 0, 0 };
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    double square_length = it->normal * it->normal;
+    if (square_length > 0)
+    {
+      double normal[3] = { it->normal.X(), it->normal.Y(), it->normal.Z() };
+      for (size_t i = 0; i < 3; ++i)
+      {
+        for (size_t j = i; j < 3; ++j)
+        {
+          normal_scatter[i][j] += normal[i] * normal[j] / square_length;
+        }
+      }
+    }
+    mean[0] += it->point.X();
+    mean[1] += it->point.Y();
+    mean[2] += it->point.Z();
+  }
+  for (size_t k = 0; k < 3; ++k)
+  {
+    mean[k] /= samples.size();
+  }
+
+  double eigenvalues[3];
+  double eigenvectors[3][3];
+  DecomposeSymmetric3x3(normal_scatter, eigenvalues, eigenvectors);
+  if (eigenvalues[1] <= 1E-6 * eigenvalues[2])
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Normals do not determine an axis!");
+    return false;
+  }
+  tPoint axis(eigenvectors[0][0], eigenvectors[0][1], eigenvectors[0][2]);
+  if (axis * this->axis_direction < 0)
+  {
+    axis = -axis;
+  }
+
+  // circle fit x^2 + y^2 + g * x + h * y + k = 0 in the cross section
+  tPoint u = math::CrossMul(std::fabs(axis.X()) < 0.9 ? tPoint(1, 0, 0) : tPoint(0, 1, 0), axis).Normalized();
+  tPoint v = math::CrossMul(axis, u);
+  double a[3][3] = {};
+  double b[3] = {};
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    tPoint q(it->point.X() - mean[0], it->point.Y() - mean[1], it->point.Z() - mean[2]);
+    double row[3] = { q * u, q * v, 1 };
+    double square_length = row[0] * row[0] + row[1] * row[1];
+    for (size_t i = 0; i < 3; ++i)
+    {
+      for (size_t j = 0; j < 3; ++j)
+      {
+        a[i][j] += row[i] * row[j];
+      }
+      b[i] -= row[i] * square_length;
+    }
+  }
+  if (!SolveLinearSystem(a, b))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine a cylinder!");
+    return false;
+  }
+
+  double square_radius = 0.25 * (b[0] * b[0] + b[1] * b[1]) - b[2];
+  if (square_radius <= 0)
+  {
+    return false;
+  }
+  this->axis_direction = axis;
+  this->axis_point = tPoint(mean[0], mean[1], mean[2]) - 0.5 * b[0] * u - 0.5 * b[1] * v;
+  this->radius = std::sqrt(square_radius);
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->axis_point, ", ", this->axis_direction, ", ", this->radius, ")");
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D GetSampleError
+//----------------------------------------------------------------------
+template <typename TElement>
+const TElement tRansacCylinder3D<TElement>::GetSampleError(const tSample &sample) const
+{
+  if (!this->CheckNormalAgreement(sample))
+  {
+    return std::numeric_limits<TElement>::infinity();
+  }
+  return std::fabs(this->GetRadialVector(sample.point).Length() - this->radius);
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D GetRadialVector
+//----------------------------------------------------------------------
+template <typename TElement>
+typename tRansacCylinder3D<TElement>::tPoint tRansacCylinder3D<TElement>::GetRadialVector(const tPoint &point) const
+{
+  tPoint v = point - this->axis_point;
+  return v - (v * this->axis_direction) * this->axis_direction;
+}
+
+//----------------------------------------------------------------------
+// tRansacCylinder3D CheckNormalAgreement
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacCylinder3D<TElement>::CheckNormalAgreement(const tSample &sample) const
+{
+  tPoint radial = this->GetRadialVector(sample.point);
+  return std::fabs(sample.normal * radial) >= this->min_normal_cosine * sample.normal.Length() * radial.Length() && !radial.IsZero() && !sample.normal.IsZero();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
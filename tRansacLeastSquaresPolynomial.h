@@ -109,6 +109,12 @@ private:
   virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
   virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
   virtual const double GetSampleError(const tSample &sample) const;
+  virtual void PrepareScoring();
+  virtual void GetSampleErrors(std::vector<double> &errors) const;
+  virtual const bool GetInlierFlags(std::vector<unsigned char> &inlier_flags, double max_error, double &total_inlier_error) const;
+
+  std::vector<double> x_values;
+  std::vector<double> y_values;
 
 };
 
@@ -32,12 +32,16 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <vector>
+#include <algorithm>
 
 #include "rrlib/math/utilities.h"
 
+#include "rrlib/logging/messages.h"
+
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/model_fitting/polynomial_residuals.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -96,19 +100,16 @@ tRansacLeastSquaresPolynomial<Tdegree>::tRansacLeastSquaresPolynomial(TIterator
 template <size_t Tdegree>
 const bool tRansacLeastSquaresPolynomial<Tdegree>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
 {
-  // ensure distinct points
-  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  assert(sample_index_set.size() == Tdegree + 1);
+  double x[Tdegree + 1];
+  double y[Tdegree + 1];
+  for (size_t i = 0; i < Tdegree + 1; ++i)
   {
-    std::vector<size_t>::const_iterator kt = it;
-    for (++kt; kt != sample_index_set.end(); ++kt)
-    {
-      if (IsEqual(this->Samples()[*it], this->Samples()[*kt]))
-      {
-        return false;
-      }
-    }
+    const tSample &sample = this->Samples()[sample_index_set[i]];
+    x[i] = sample.X();
+    y[i] = sample.Y();
   }
-  return this->FitToSampleIndexSet(sample_index_set);
+  return this->Interpolate(x, y);
 }
 
 //----------------------------------------------------------------------
@@ -117,19 +118,25 @@ const bool tRansacLeastSquaresPolynomial<Tdegree>::FitToMinimalSampleIndexSet(co
 template <size_t Tdegree>
 const bool tRansacLeastSquaresPolynomial<Tdegree>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
 {
-  std::vector<tSample> chosen_samples;
-  chosen_samples.reserve(sample_index_set.size());
+  assert(!sample_index_set.empty());
+  std::vector<tSample> samples;
+  samples.reserve(sample_index_set.size());
   for (typename std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
   {
-    chosen_samples.push_back(this->Samples()[*it]);
+    samples.push_back(this->Samples()[*it]);
   }
-  try
+
+  double offset, scale;
+  this->GetNormalization(samples.begin(), samples.end(), offset, scale);
+
+  typename tLeastSquaresPolynomial::tMoments moments;
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
   {
-    this->UpdateModelFromSampleSet(chosen_samples.begin(), chosen_samples.end());
+    moments.Add(tSample((it->X() - offset) / scale, it->Y()));
   }
-  catch (std::logic_error &exception)
+  if (!this->SolveNormalEquations(moments, offset, scale))
   {
-    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Failed to update model from sample set: ", exception.what());
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Failed to update model from sample set.");
     return false;
   }
   return true;
@@ -144,6 +151,54 @@ const double tRansacLeastSquaresPolynomial<Tdegree>::GetSampleError(const tSampl
   return math::AbsoluteValue(sample.Y() - (*this)(sample.X()));
 }
 
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomial PrepareScoring
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tRansacLeastSquaresPolynomial<Tdegree>::PrepareScoring()
+{
+  this->x_values.resize(this->Samples().size());
+  this->y_values.resize(this->Samples().size());
+  for (size_t i = 0; i < this->Samples().size(); ++i)
+  {
+    this->x_values[i] = this->Samples()[i].X();
+    this->y_values[i] = this->Samples()[i].Y();
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomial GetSampleErrors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tRansacLeastSquaresPolynomial<Tdegree>::GetSampleErrors(std::vector<double> &errors) const
+{
+  assert(this->x_values.size() == this->Samples().size());
+  double coefficients[Tdegree + 1];
+  for (size_t i = 0; i < Tdegree + 1; ++i)
+  {
+    coefficients[i] = this->GetCoefficient(i);
+  }
+  errors.resize(this->x_values.size());
+  EvaluatePolynomialResiduals<Tdegree>(coefficients, this->x_values.data(), this->y_values.data(), this->x_values.size(), errors.data());
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomial GetInlierFlags
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tRansacLeastSquaresPolynomial<Tdegree>::GetInlierFlags(std::vector<unsigned char> &inlier_flags, double max_error, double &total_inlier_error) const
+{
+  assert(this->x_values.size() == this->Samples().size());
+  double coefficients[Tdegree + 1];
+  for (size_t i = 0; i < Tdegree + 1; ++i)
+  {
+    coefficients[i] = this->GetCoefficient(i);
+  }
+  inlier_flags.resize(this->x_values.size());
+  CountPolynomialInliers<Tdegree>(coefficients, this->x_values.data(), this->y_values.data(), this->x_values.size(), max_error, inlier_flags.data(), total_inlier_error);
+  return true;
+}
+
 //----------------------------------------------------------------------
 // End of namespace declaration
 //----------------------------------------------------------------------
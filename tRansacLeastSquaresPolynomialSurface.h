@@ -0,0 +1,132 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacLeastSquaresPolynomialSurface.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRansacLeastSquaresPolynomialSurface
+ *
+ * \b tRansacLeastSquaresPolynomialSurface
+ *
+ * RANSAC fitting of bivariate polynomial surfaces z = f(x, y).
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tRansacLeastSquaresPolynomialSurface_h__
+#define __rrlib__model_fitting__tRansacLeastSquaresPolynomialSurface_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tLeastSquaresPolynomialSurface.h"
+#include "rrlib/model_fitting/tRansacModel.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! RANSAC fitting of bivariate polynomial surfaces z = f(x, y)
+/*! Minimal sample sets of (Tdegree + 1) * (Tdegree + 2) / 2 points are
+ *  interpolated exactly, consensus sets are fitted by least squares, and
+ *  the vertical residuals |z - f(x, y)| of all samples are computed by a
+ *  batch kernel on contiguous coordinate arrays.
+ */
+template <size_t Tdegree>
+class tRansacLeastSquaresPolynomialSurface : public tLeastSquaresPolynomialSurface<Tdegree>,
+  public tRansacModel<typename tLeastSquaresPolynomialSurface<Tdegree>::tSample>
+{
+
+  typedef model_fitting::tRansacModel<typename tLeastSquaresPolynomialSurface<Tdegree>::tSample> tRansacModel;
+  typedef model_fitting::tLeastSquaresPolynomialSurface<Tdegree> tLeastSquaresPolynomialSurface;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef typename tLeastSquaresPolynomialSurface::tSample tSample;
+
+  explicit tRansacLeastSquaresPolynomialSurface(bool local_optimization = false);
+
+  template <typename TIterator>
+  tRansacLeastSquaresPolynomialSurface(TIterator begin, TIterator end,
+                                       unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
+                                       bool local_optimization = false);
+
+  const size_t MinimalSetSize() const
+  {
+    return tLeastSquaresPolynomialSurface::cNUMBER_OF_COEFFICIENTS;
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tRansacLeastSquaresPolynomialSurface";
+  }
+
+  virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual const double GetSampleError(const tSample &sample) const;
+  virtual void PrepareScoring();
+  virtual void GetSampleErrors(std::vector<double> &errors) const;
+
+  std::vector<double> x_values;
+  std::vector<double> y_values;
+  std::vector<double> z_values;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tRansacLeastSquaresPolynomialSurface.hpp"
+
+#endif
@@ -0,0 +1,184 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacLeastSquaresPolynomialSurface.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/polynomial_residuals.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tRansacLeastSquaresPolynomialSurface<Tdegree>::tRansacLeastSquaresPolynomialSurface(bool local_optimization)
+  : tRansacModel(local_optimization)
+{}
+
+template <size_t Tdegree>
+template <typename TIterator>
+tRansacLeastSquaresPolynomialSurface<Tdegree>::tRansacLeastSquaresPolynomialSurface(TIterator begin, TIterator end,
+    unsigned int max_iterations, double satisfactory_support_ratio, double max_error,
+    bool local_optimization)
+  : tRansacModel(local_optimization)
+{
+  this->Initialize(std::distance(begin, end));
+  this->AddSamples(begin, end);
+  if (!this->DoRANSAC(max_iterations, satisfactory_support_ratio, max_error))
+  {
+    throw std::runtime_error("Failed to fit RANSAC model during construction!");
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface FitToMinimalSampleIndexSet
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tRansacLeastSquaresPolynomialSurface<Tdegree>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  const size_t n = tLeastSquaresPolynomialSurface::cNUMBER_OF_COEFFICIENTS;
+  assert(sample_index_set.size() == n);
+  double x[n];
+  double y[n];
+  double z[n];
+  for (size_t i = 0; i < n; ++i)
+  {
+    const tSample &sample = this->Samples()[sample_index_set[i]];
+    x[i] = sample.X();
+    y[i] = sample.Y();
+    z[i] = sample.Z();
+  }
+  return this->Interpolate(x, y, z);
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface FitToSampleIndexSet
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tRansacLeastSquaresPolynomialSurface<Tdegree>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  std::vector<tSample> samples;
+  samples.reserve(sample_index_set.size());
+  for (typename std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  {
+    samples.push_back(this->Samples()[*it]);
+  }
+
+  double x_offset, x_scale, y_offset, y_scale;
+  this->GetNormalization(samples.begin(), samples.end(), x_offset, x_scale, y_offset, y_scale);
+
+  typename tLeastSquaresPolynomialSurface::tMoments moments;
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    moments.Add(tSample((it->X() - x_offset) / x_scale, (it->Y() - y_offset) / y_scale, it->Z()));
+  }
+  if (!this->SolveNormalEquations(moments, x_offset, x_scale, y_offset, y_scale))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Failed to update model from sample set.");
+    return false;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface GetSampleError
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const double tRansacLeastSquaresPolynomialSurface<Tdegree>::GetSampleError(const tSample &sample) const
+{
+  return std::fabs(sample.Z() - (*this)(sample.X(), sample.Y()));
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface PrepareScoring
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tRansacLeastSquaresPolynomialSurface<Tdegree>::PrepareScoring()
+{
+  this->x_values.resize(this->Samples().size());
+  this->y_values.resize(this->Samples().size());
+  this->z_values.resize(this->Samples().size());
+  for (size_t i = 0; i < this->Samples().size(); ++i)
+  {
+    this->x_values[i] = this->Samples()[i].X();
+    this->y_values[i] = this->Samples()[i].Y();
+    this->z_values[i] = this->Samples()[i].Z();
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacLeastSquaresPolynomialSurface GetSampleErrors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tRansacLeastSquaresPolynomialSurface<Tdegree>::GetSampleErrors(std::vector<double> &errors) const
+{
+  assert(this->x_values.size() == this->Samples().size());
+  errors.resize(this->x_values.size());
+  EvaluatePolynomialSurfaceResiduals<Tdegree>(this->Coefficients(), this->x_values.data(), this->y_values.data(), this->z_values.data(), this->x_values.size(), errors.data());
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -41,6 +41,11 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <vector>
+#include <unordered_set>
+#include <cstdint>
+#include <atomic>
+#include <functional>
+#include <algorithm>
 
 //----------------------------------------------------------------------
 // Internal includes with ""
@@ -69,8 +74,12 @@ namespace model_fitting
 /*! A general base class that implements the RANSAC algorithm for an
  *  arbitrary model. The model specific details need to be implemented in
  *  a derived class.
+ *
+ *  TError is the type of the per-sample errors. Models with single
+ *  precision samples can use float to halve the bandwidth of scoring,
+ *  while totals are always accumulated in double.
  */
-template <typename TSample>
+template <typename TSample, typename TError = double>
 class tRansacModel
 {
 
@@ -80,6 +89,30 @@ class tRansacModel
 public:
 
   typedef TSample tSample;
+  typedef TError tError;
+
+  /*!
+   * \brief Called by DoRANSAC whenever a better model was found, while the model holds it
+   *
+   * The arguments are the support and the total inlier error of the new model.
+   */
+  typedef std::function<void(size_t support, double total_error)> tImprovementHandler;
+
+  /*!
+   * \brief The policies that can be used to compare hypotheses
+   *
+   * INLIER_COUNT          Maximize the number of samples with an error below max_error (total inlier error breaks ties)
+   * TRUNCATED_QUADRATIC   Minimize the MSAC loss min(e^2 / max_error^2, 1)
+   * SIGMA_CONSENSUS       Minimize the truncated quadratic loss marginalized over thresholds uniformly
+   *                       distributed in [0, max_error], which is u * (2 - u) with u = min(e / max_error, 1).
+   *                       That makes max_error an upper bound of the noise scale instead of a hard threshold.
+   */
+  enum class tScoringPolicy
+  {
+    INLIER_COUNT,
+    TRUNCATED_QUADRATIC,
+    SIGMA_CONSENSUS
+  };
 
   explicit tRansacModel(bool local_optimization = false);
 
@@ -92,6 +125,7 @@ public:
   inline void AddSample(const tSample &sample)
   {
     this->samples.push_back(sample);
+    this->SamplesChanged();
   }
 
   template <typename TIterator>
@@ -102,6 +136,7 @@ public:
     {
       this->samples.push_back(*it);
     }
+    this->SamplesChanged();
   }
 
   inline void SetLocalOptimization(bool enabled)
@@ -109,8 +144,84 @@ public:
     this->local_optimization = enabled;
   }
 
+  inline void SetScoringPolicy(tScoringPolicy scoring_policy)
+  {
+    this->scoring_policy = scoring_policy;
+  }
+
+  inline void SetImprovementHandler(const tImprovementHandler &improvement_handler)
+  {
+    this->improvement_handler = improvement_handler;
+  }
+
+  /*!
+   * \brief Let DoRANSAC stop (and fail) at the next iteration once the given flag is set
+   *
+   * The flag must outlive all calls to DoRANSAC. Pass NULL to remove it.
+   */
+  inline void SetCancellationFlag(const std::atomic<bool> *cancellation_flag)
+  {
+    this->cancellation_flag = cancellation_flag;
+  }
+
   const bool DoRANSAC(unsigned int max_iterations, double satisfactory_inlier_ratio = 1.0, double max_error = 1E-6);
 
+  /*!
+   * \brief Find an unknown number of model instances in one pass (J-linkage)
+   *
+   * Every sample is represented by a packed bitset of the hypotheses from
+   * random minimal sets it is an inlier of. Samples are then clustered
+   * agglomeratively by the Jaccard distance of these preference sets, which
+   * is computed via popcount. A merged cluster keeps the intersection of its
+   * members' preferences, so merging stops when no two clusters share a
+   * hypothesis anymore. Clusters smaller than min_structure_size are treated
+   * as outliers.
+   *
+   * On success, the model is fitted to the largest structure.
+   *
+   * \param number_of_hypotheses   The number of minimal sets to draw
+   * \param max_error              The maximal error of a sample that prefers a hypothesis
+   * \param min_structure_size     The minimal number of samples that form a model instance
+   *
+   * \return Whether at least one structure was found
+   */
+  const bool DoJLinkage(unsigned int number_of_hypotheses, double max_error, size_t min_structure_size);
+
+  /*!
+   * \brief Find an unknown number of model instances in one pass (T-linkage)
+   *
+   * Works like DoJLinkage, but a sample prefers a hypothesis with
+   * exp(-e / tau), where tau = max_error / 5, instead of a binary flag.
+   * Clusters are merged by the Tanimoto distance of these preference
+   * vectors and keep their element-wise minimum. Soft preferences separate
+   * structures that share many marginal inliers better, but need a float
+   * per sample and hypothesis instead of a bit.
+   *
+   * \param number_of_hypotheses   The number of minimal sets to draw
+   * \param max_error              The maximal error of a sample that prefers a hypothesis at all
+   * \param min_structure_size     The minimal number of samples that form a model instance
+   *
+   * \return Whether at least one structure was found
+   */
+  const bool DoTLinkage(unsigned int number_of_hypotheses, double max_error, size_t min_structure_size);
+
+  /*!
+   * \brief The sample index sets of the structures found by DoJLinkage or DoTLinkage, sorted by decreasing size
+   */
+  inline const std::vector<std::vector<size_t>> &Structures() const
+  {
+    return this->structures;
+  }
+
+  /*!
+   * \brief Fit the model to one of the structures found by DoJLinkage or DoTLinkage
+   *
+   * Updates Assignments(), NumberOfInliers(), InlierRatio(), Error() and
+   * Loss() accordingly. The loss is determined over all samples with the
+   * max_error of the linkage.
+   */
+  const bool SelectStructure(size_t index);
+
   inline const std::vector<tSample> &Samples() const
   {
     return this->samples;
@@ -136,31 +247,224 @@ public:
     return this->error;
   }
 
+  inline const double Loss() const
+  {
+    return this->loss;
+  }
+
   virtual const size_t MinimalSetSize() const = 0;
 
+//----------------------------------------------------------------------
+// Protected methods
+//----------------------------------------------------------------------
+protected:
+
+  /*!
+   * \brief Draw a random minimal set of distinct sample indices
+   *
+   * The default draws uniformly from all samples. Models can override
+   * this to exploit the structure of their samples, e.g. spatial locality.
+   */
+  virtual void GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const;
+
+  /*!
+   * \brief Called whenever samples are cleared or added
+   *
+   * Models that keep state derived from the current samples reset it here.
+   */
+  virtual void SamplesChanged()
+  {}
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
 private:
 
+  enum { cMAX_REDRAWS_PER_INDEX = 4 };
+
   bool local_optimization;
+  tScoringPolicy scoring_policy;
   std::vector<tSample> samples;
   std::vector<bool> assignments;
   size_t number_of_inliers;
   double inlier_ratio;
   double error;
+  double loss;
+  std::vector<std::vector<size_t>> structures;
+  double structure_max_error;
+  tImprovementHandler improvement_handler;
+  const std::atomic<bool> *cancellation_flag;
+  mutable std::vector<TError> sample_errors;
+  mutable std::vector<size_t> candidate_index_set;
+  mutable std::vector<unsigned char> inlier_flags;
 
   virtual const char *GetLogDescription() const
   {
     return "tRansacModel";
   }
 
-  void GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const;
-  double DetermineConsensusIndexSet(std::vector<size_t> &consensus_index_set, double max_error) const;
+  struct tIndexSetHash
+  {
+    size_t operator()(const std::vector<size_t> &index_set) const
+    {
+      size_t hash = 0;
+      for (std::vector<size_t>::const_iterator it = index_set.begin(); it != index_set.end(); ++it)
+      {
+        hash ^= std::hash<size_t>()(*it) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+      return hash;
+    }
+  };
+
+  typedef std::unordered_set<std::vector<size_t>, tIndexSetHash> tIndexSetHashSet;
+
+  /*!
+   * \brief Get the number of distinct minimal sets that can be drawn from the samples
+   *
+   * \param limit   The counting stops as soon as this value is exceeded
+   *
+   * \return C(N, MinimalSetSize()) or limit + 1 if the binomial coefficient is larger than limit
+   */
+  size_t NumberOfMinimalSets(size_t limit) const;
+
+  /*!
+   * \brief Advance to the next index set in lexicographic order
+   *
+   * An empty index set is initialized with the first combination.
+   *
+   * \return Whether a next index set existed
+   */
+  bool GenerateNextIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const;
+
+  /*!
+   * \brief Draw a random minimal set that has not been evaluated, yet, and add it to evaluated_index_sets
+   *
+   * Overrides of GenerateRandomIndexSet may reach fewer distinct sets than
+   * are requested. The number of redraws is therefore bounded. After
+   * cMAX_REDRAWS_PER_INDEX draws per index, the remaining ones are
+   * uniform, and if these also fail, a duplicate is evaluated again.
+   */
+  void GenerateUnseenRandomIndexSet(std::vector<size_t> &index_set, std::vector<size_t> &sorted_index_set, size_t max_index,
+                                    tIndexSetHashSet &evaluated_index_sets) const;
+
+  /*!
+   * \brief Fit models to random minimal sets and pass the sample errors of each to record_preferences
+   *
+   * Fewer hypotheses are generated if there are not more distinct minimal sets.
+   */
+  template <typename TRecordPreferences>
+  void GeneratePreferences(unsigned int number_of_hypotheses, TRecordPreferences record_preferences);
+
+  /*!
+   * \brief Cluster the samples agglomeratively by the distance of their preference sets
+   *
+   * preference_sets holds one set of set_size elements per sample. Merged
+   * clusters keep the intersection of their preferences. The resulting
+   * structures are stored, sorted by decreasing size.
+   */
+  template <typename TPreference>
+  void ClusterPreferenceSets(std::vector<TPreference> &preference_sets, size_t set_size, size_t min_structure_size);
+
+  static inline size_t PopulationCount(uint64_t word)
+  {
+#ifdef __GNUC__
+    return __builtin_popcountll(word);
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (word * 0x0101010101010101ULL) >> 56;
+#endif
+  }
+
+  /*!
+   * \brief The Jaccard distance of two packed bitsets
+   */
+  static double PreferenceDistance(const uint64_t *a, const uint64_t *b, size_t number_of_words);
+
+  /*!
+   * \brief The Tanimoto distance of two real-valued preference vectors
+   */
+  static double PreferenceDistance(const float *a, const float *b, size_t number_of_hypotheses);
+
+  static inline void IntersectPreferences(uint64_t &a, uint64_t b)
+  {
+    a &= b;
+  }
+  static inline void IntersectPreferences(float &a, float b)
+  {
+    a = std::min(a, b);
+  }
+
+  double DetermineConsensusIndexSet(std::vector<size_t> &consensus_index_set, double max_error, double &total_loss) const;
+
+  inline double GetSampleLoss(double error, double max_error) const
+  {
+    switch (this->scoring_policy)
+    {
+    case tScoringPolicy::TRUNCATED_QUADRATIC:
+    {
+      double u = std::min(error / max_error, 1.0);
+      return u * u;
+    }
+    case tScoringPolicy::SIGMA_CONSENSUS:
+    {
+      double u = std::min(error / max_error, 1.0);
+      return u * (2.0 - u);
+    }
+    default:
+      return error <= max_error ? 0.0 : 1.0;
+    }
+  }
 
   virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set) = 0;
   virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set) = 0;
-  virtual const double GetSampleError(const tSample &sample) const = 0;
+  virtual const TError GetSampleError(const tSample &sample) const = 0;
+
+  /*!
+   * \brief Called before hypotheses are scored on the current set of samples
+   *
+   * Models can use this to build data structures for GetSampleErrors.
+   */
+  virtual void PrepareScoring()
+  {}
+
+  /*!
+   * \brief Compute the errors of all samples for the current model
+   *
+   * The default implementation calls GetSampleError for every sample.
+   * Models can override this with a batch kernel.
+   */
+  virtual void GetSampleErrors(std::vector<TError> &errors) const;
+
+  /*!
+   * \brief Get a superset of the samples whose error can be at most max_error for the current model
+   *
+   * Models with a spatial index can override this, so that scoring only
+   * computes the errors of these samples and counts all others as
+   * outliers. The default returns false to score all samples.
+   *
+   * \return Whether the candidate index set was determined
+   */
+  virtual const bool GetCandidateIndexSet(std::vector<size_t> &/*candidate_index_set*/, double /*max_error*/) const
+  {
+    return false;
+  }
+
+  /*!
+   * \brief Flag the samples whose error is at most max_error for the current model
+   *
+   * The loss of the INLIER_COUNT scoring policy only depends on these
+   * flags, so models with a batch kernel can override this to classify
+   * all samples in a single pass without storing their errors. The
+   * default returns false to score via GetSampleErrors.
+   *
+   * \return Whether the inlier flags were determined
+   */
+  virtual const bool GetInlierFlags(std::vector<unsigned char> &/*inlier_flags*/, double /*max_error*/, double &/*total_inlier_error*/) const
+  {
+    return false;
+  }
 
 };
 
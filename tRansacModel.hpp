@@ -33,6 +33,8 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <cstdlib>
+#include <cmath>
+#include <limits>
 #include <algorithm>
 
 #include "rrlib/util/join.h"
@@ -71,25 +73,30 @@ namespace model_fitting
 //----------------------------------------------------------------------
 // tRansacModel constructors
 //----------------------------------------------------------------------
-template <typename TSample>
-tRansacModel<TSample>::tRansacModel(bool local_optimization)
+template <typename TSample, typename TError>
+tRansacModel<TSample, TError>::tRansacModel(bool local_optimization)
   : local_optimization(local_optimization),
+    scoring_policy(tScoringPolicy::INLIER_COUNT),
+    number_of_inliers(0),
     inlier_ratio(0),
-    error(0)
+    error(0),
+    loss(0),
+    structure_max_error(0),
+    cancellation_flag(NULL)
 {}
 
 //----------------------------------------------------------------------
 // tRansacModel destructor
 //----------------------------------------------------------------------
-template <typename TSample>
-tRansacModel<TSample>::~tRansacModel()
+template <typename TSample, typename TError>
+tRansacModel<TSample, TError>::~tRansacModel()
 {}
 
 //----------------------------------------------------------------------
 // tRansacModel Initialize
 //----------------------------------------------------------------------
-template <typename TSample>
-void tRansacModel<TSample>::Initialize(unsigned int expected_number_of_samples)
+template <typename TSample, typename TError>
+void tRansacModel<TSample, TError>::Initialize(unsigned int expected_number_of_samples)
 {
   this->Clear();
   this->samples.reserve(expected_number_of_samples);
@@ -99,21 +106,25 @@ void tRansacModel<TSample>::Initialize(unsigned int expected_number_of_samples)
 //----------------------------------------------------------------------
 // tRansacModel Clear
 //----------------------------------------------------------------------
-template <typename TSample>
-void tRansacModel<TSample>::Clear()
+template <typename TSample, typename TError>
+void tRansacModel<TSample, TError>::Clear()
 {
   this->samples.clear();
   this->assignments.clear();
+  this->number_of_inliers = 0;
   this->inlier_ratio = 0;
   this->error = 0;
+  this->loss = 0;
+  this->structures.clear();
+  this->SamplesChanged();
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Model cleared.");
 }
 
 //----------------------------------------------------------------------
 // tRansacModel DoRANSAC
 //----------------------------------------------------------------------
-template <typename TSample>
-const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double satisfactory_inlier_ratio, double max_error)
+template <typename TSample, typename TError>
+const bool tRansacModel<TSample, TError>::DoRANSAC(unsigned int max_iterations, double satisfactory_inlier_ratio, double max_error)
 {
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Performing RANSAC algorithm.");
 
@@ -123,6 +134,8 @@ const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double s
     return false;
   }
 
+  this->PrepareScoring();
+
   std::vector<size_t> minimal_index_set;
   minimal_index_set.reserve(this->MinimalSetSize());
 
@@ -135,14 +148,42 @@ const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double s
   size_t satisfactory_support = std::round(satisfactory_inlier_ratio * this->samples.size());
   size_t max_support = 0;
   double min_error = std::numeric_limits<double>::max();
+  double min_loss = std::numeric_limits<double>::max();
+
+  // if there are not more distinct minimal sets than iterations, enumerate all of them instead of drawing with replacement
+  size_t number_of_minimal_sets = this->NumberOfMinimalSets(max_iterations);
+  bool exhaustive = number_of_minimal_sets <= max_iterations;
+  if (exhaustive)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Only ", number_of_minimal_sets, " distinct minimal sets exist. Enumerating all of them.");
+    max_iterations = number_of_minimal_sets;
+  }
+
+  tIndexSetHashSet evaluated_index_sets;
+  std::vector<size_t> sorted_index_set;
+  sorted_index_set.reserve(this->MinimalSetSize());
 
   // main RANSAC loop
   for (unsigned int iteration = 0; iteration < max_iterations; ++iteration)
   {
     RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Iteration: ", iteration);
 
-    // generate indices for minimal random subset of all samples
-    this->GenerateRandomIndexSet(minimal_index_set, this->MinimalSetSize(), this->samples.size() - 1);
+    if (this->cancellation_flag && this->cancellation_flag->load(std::memory_order_relaxed))
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "RANSAC was cancelled.");
+      return false;
+    }
+
+    if (exhaustive)
+    {
+      // generate indices for next minimal subset in lexicographic order
+      this->GenerateNextIndexSet(minimal_index_set, this->MinimalSetSize(), this->samples.size() - 1);
+    }
+    else
+    {
+      // generate indices for minimal random subset of all samples that has not been evaluated, yet
+      this->GenerateUnseenRandomIndexSet(minimal_index_set, sorted_index_set, this->samples.size() - 1, evaluated_index_sets);
+    }
 
     RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Random subset: ", util::Join(minimal_index_set, ", "));
 
@@ -153,18 +194,25 @@ const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double s
       continue;
     }
 
-    double total_error = this->DetermineConsensusIndexSet(consensus_index_set, max_error);
+    double total_loss;
+    double total_error = this->DetermineConsensusIndexSet(consensus_index_set, max_error, total_loss);
     size_t support = consensus_index_set.size();
 
-    // proceed if we found better support or lower error
-    if (support > max_support || (support == max_support && total_error < min_error))
+    // proceed if we found lower loss (i.e. better support for INLIER_COUNT) or lower error
+    if (total_loss < min_loss || (total_loss == min_loss && total_error < min_error))
     {
-      RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Found better model with support ", support, " and total inlier error ", total_error);
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Found better model with support ", support, ", total loss ", total_loss, " and total inlier error ", total_error);
 
       max_support = support;
       min_error = total_error;
+      min_loss = total_loss;
       best_consensus_index_set = consensus_index_set;
 
+      if (this->improvement_handler)
+      {
+        this->improvement_handler(max_support, min_error);
+      }
+
       if (this->local_optimization)
       {
         if (!this->FitToSampleIndexSet(best_consensus_index_set))
@@ -173,16 +221,22 @@ const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double s
         }
         else
         {
-          double total_error = this->DetermineConsensusIndexSet(consensus_index_set, max_error);
+          double total_error = this->DetermineConsensusIndexSet(consensus_index_set, max_error, total_loss);
           size_t support = consensus_index_set.size();
 
-          if (support > max_support || (support == max_support && total_error < min_error))
+          if (total_loss < min_loss || (total_loss == min_loss && total_error < min_error))
           {
-            RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Local Optimization yielded better model with support ", support, " and total inlier error ", total_error);
+            RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Local Optimization yielded better model with support ", support, ", total loss ", total_loss, " and total inlier error ", total_error);
 
             max_support = support;
             min_error = total_error;
+            min_loss = total_loss;
             best_consensus_index_set = consensus_index_set;
+
+            if (this->improvement_handler)
+            {
+              this->improvement_handler(max_support, min_error);
+            }
           }
         }
       }
@@ -221,15 +275,319 @@ const bool tRansacModel<TSample>::DoRANSAC(unsigned int max_iterations, double s
   this->number_of_inliers = max_support;
   this->inlier_ratio = static_cast<double>(max_support) / this->samples.size();
   this->error = min_error / this->number_of_inliers;
+  this->loss = min_loss;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacModel DoJLinkage
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+const bool tRansacModel<TSample, TError>::DoJLinkage(unsigned int number_of_hypotheses, double max_error, size_t min_structure_size)
+{
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Performing J-linkage.");
+
+  this->structures.clear();
+  this->structure_max_error = max_error;
+
+  if (this->samples.size() < this->MinimalSetSize())
+  {
+    RRLIB_LOG_PRINT(ERROR, "At least ", this->MinimalSetSize(), " samples must be added to construct model!");
+    return false;
+  }
+
+  const size_t number_of_samples = this->samples.size();
+  const size_t number_of_words = (number_of_hypotheses + 63) / 64;
+
+  // preference sets of all samples (later: of all clusters), number_of_words each
+  std::vector<uint64_t> preference_sets(number_of_samples * number_of_words, 0);
+
+  this->GeneratePreferences(number_of_hypotheses, [&](size_t hypothesis, const std::vector<TError> &sample_errors)
+  {
+    const size_t word = hypothesis / 64;
+    const uint64_t bit = uint64_t(1) << (hypothesis % 64);
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      if (sample_errors[i] <= max_error)
+      {
+        preference_sets[i * number_of_words + word] |= bit;
+      }
+    }
+  });
+
+  this->ClusterPreferenceSets(preference_sets, number_of_words, min_structure_size);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Found ", this->structures.size(), " structures.");
+
+  if (this->structures.empty())
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to find a structure. Could not construct model.");
+    return false;
+  }
+
+  return this->SelectStructure(0);
+}
+
+//----------------------------------------------------------------------
+// tRansacModel DoTLinkage
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+const bool tRansacModel<TSample, TError>::DoTLinkage(unsigned int number_of_hypotheses, double max_error, size_t min_structure_size)
+{
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Performing T-linkage.");
+
+  this->structures.clear();
+  this->structure_max_error = max_error;
+
+  if (this->samples.size() < this->MinimalSetSize())
+  {
+    RRLIB_LOG_PRINT(ERROR, "At least ", this->MinimalSetSize(), " samples must be added to construct model!");
+    return false;
+  }
+
+  const size_t number_of_samples = this->samples.size();
+  number_of_hypotheses = std::min<size_t>(number_of_hypotheses, this->NumberOfMinimalSets(number_of_hypotheses));
+
+  // preference vectors of all samples (later: of all clusters), number_of_hypotheses each
+  std::vector<float> preference_sets(number_of_samples * number_of_hypotheses, 0.0f);
+
+  const double tau = max_error / 5;
+  this->GeneratePreferences(number_of_hypotheses, [&](size_t hypothesis, const std::vector<TError> &sample_errors)
+  {
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      if (sample_errors[i] <= max_error)
+      {
+        preference_sets[i * number_of_hypotheses + hypothesis] = std::exp(-sample_errors[i] / tau);
+      }
+    }
+  });
+
+  this->ClusterPreferenceSets(preference_sets, number_of_hypotheses, min_structure_size);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Found ", this->structures.size(), " structures.");
+
+  if (this->structures.empty())
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to find a structure. Could not construct model.");
+    return false;
+  }
+
+  return this->SelectStructure(0);
+}
+
+//----------------------------------------------------------------------
+// tRansacModel GeneratePreferences
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+template <typename TRecordPreferences>
+void tRansacModel<TSample, TError>::GeneratePreferences(unsigned int number_of_hypotheses, TRecordPreferences record_preferences)
+{
+  this->PrepareScoring();
+
+  const size_t number_of_samples = this->samples.size();
+
+  std::vector<size_t> minimal_index_set;
+  minimal_index_set.reserve(this->MinimalSetSize());
+  std::vector<size_t> sorted_index_set;
+  sorted_index_set.reserve(this->MinimalSetSize());
+  tIndexSetHashSet evaluated_index_sets;
+
+  size_t number_of_minimal_sets = this->NumberOfMinimalSets(number_of_hypotheses);
+  bool exhaustive = number_of_minimal_sets <= number_of_hypotheses;
+  if (exhaustive)
+  {
+    number_of_hypotheses = number_of_minimal_sets;
+  }
+
+  for (unsigned int hypothesis = 0; hypothesis < number_of_hypotheses; ++hypothesis)
+  {
+    if (exhaustive)
+    {
+      this->GenerateNextIndexSet(minimal_index_set, this->MinimalSetSize(), number_of_samples - 1);
+    }
+    else
+    {
+      this->GenerateUnseenRandomIndexSet(minimal_index_set, sorted_index_set, number_of_samples - 1, evaluated_index_sets);
+    }
+
+    if (!this->FitToMinimalSampleIndexSet(minimal_index_set))
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Failed to construct model from minimal sample set. Skipping hypothesis.");
+      continue;
+    }
+
+    this->GetSampleErrors(this->sample_errors);
+    record_preferences(hypothesis, this->sample_errors);
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacModel ClusterPreferenceSets
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+template <typename TPreference>
+void tRansacModel<TSample, TError>::ClusterPreferenceSets(std::vector<TPreference> &preference_sets, size_t set_size, size_t min_structure_size)
+{
+  const size_t number_of_samples = this->samples.size();
+
+  // agglomerative clustering with cached nearest neighbors
+  std::vector<std::vector<size_t>> clusters(number_of_samples);
+  std::vector<bool> active(number_of_samples, true);
+  std::vector<size_t> nearest_neighbor(number_of_samples, 0);
+  std::vector<double> nearest_distance(number_of_samples, 1.0);
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    clusters[i].push_back(i);
+  }
+
+  auto update_nearest_neighbor = [&](size_t i)
+  {
+    nearest_distance[i] = 1.0;
+    for (size_t k = 0; k < number_of_samples; ++k)
+    {
+      if (k == i || !active[k])
+      {
+        continue;
+      }
+      double distance = PreferenceDistance(&preference_sets[i * set_size], &preference_sets[k * set_size], set_size);
+      if (distance < nearest_distance[i])
+      {
+        nearest_distance[i] = distance;
+        nearest_neighbor[i] = k;
+      }
+      if (distance < nearest_distance[k])
+      {
+        nearest_distance[k] = distance;
+        nearest_neighbor[k] = i;
+      }
+    }
+  };
+
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    update_nearest_neighbor(i);
+  }
+
+  while (true)
+  {
+    size_t a = 0;
+    double min_distance = 1.0;
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      if (active[i] && nearest_distance[i] < min_distance)
+      {
+        min_distance = nearest_distance[i];
+        a = i;
+      }
+    }
+    if (min_distance >= 1.0)
+    {
+      break;
+    }
+
+    size_t b = nearest_neighbor[a];
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Merging clusters ", a, " and ", b, " with distance ", min_distance);
+
+    for (size_t w = 0; w < set_size; ++w)
+    {
+      IntersectPreferences(preference_sets[a * set_size + w], preference_sets[b * set_size + w]);
+    }
+    clusters[a].insert(clusters[a].end(), clusters[b].begin(), clusters[b].end());
+    clusters[b].clear();
+    active[b] = false;
+
+    for (size_t i = 0; i < number_of_samples; ++i)
+    {
+      if (active[i] && (i == a || nearest_neighbor[i] == a || nearest_neighbor[i] == b))
+      {
+        update_nearest_neighbor(i);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    if (active[i] && clusters[i].size() >= std::max(min_structure_size, this->MinimalSetSize()))
+    {
+      std::sort(clusters[i].begin(), clusters[i].end());
+      this->structures.push_back(clusters[i]);
+    }
+  }
+  std::sort(this->structures.begin(), this->structures.end(), [](const std::vector<size_t> &a, const std::vector<size_t> &b)
+  {
+    return a.size() > b.size();
+  });
+}
+
+//----------------------------------------------------------------------
+// tRansacModel SelectStructure
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+const bool tRansacModel<TSample, TError>::SelectStructure(size_t index)
+{
+  assert(index < this->structures.size());
+  const std::vector<size_t> &structure = this->structures[index];
+
+  if (!this->FitToSampleIndexSet(structure))
+  {
+    RRLIB_LOG_PRINT(ERROR, "Failed to construct model from structure ", index, ".");
+    return false;
+  }
+
+  this->PrepareScoring();
+  this->GetSampleErrors(this->sample_errors);
+
+  double total_error = 0.0;
+  this->assignments.assign(this->samples.size(), false);
+  for (typename std::vector<size_t>::const_iterator it = structure.begin(); it != structure.end(); ++it)
+  {
+    this->assignments[*it] = true;
+    total_error += this->sample_errors[*it];
+  }
+
+  double total_loss = 0.0;
+  for (typename std::vector<TError>::const_iterator it = this->sample_errors.begin(); it != this->sample_errors.end(); ++it)
+  {
+    total_loss += this->GetSampleLoss(*it, this->structure_max_error);
+  }
+
+  this->number_of_inliers = structure.size();
+  this->inlier_ratio = static_cast<double>(structure.size()) / this->samples.size();
+  this->error = total_error / structure.size();
+  this->loss = total_loss;
 
   return true;
 }
 
+//----------------------------------------------------------------------
+// tRansacModel NumberOfMinimalSets
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+size_t tRansacModel<TSample, TError>::NumberOfMinimalSets(size_t limit) const
+{
+  size_t n = this->samples.size();
+  size_t k = std::min(this->MinimalSetSize(), n - this->MinimalSetSize());
+
+  // C(n - k + i, i) is exact and grows monotonically in i, so we can stop as soon as limit is exceeded
+  size_t number_of_minimal_sets = 1;
+  for (size_t i = 1; i <= k; ++i)
+  {
+    number_of_minimal_sets = number_of_minimal_sets * (n - k + i) / i;
+    if (number_of_minimal_sets > limit)
+    {
+      return limit + 1;
+    }
+  }
+  return number_of_minimal_sets;
+}
+
 //----------------------------------------------------------------------
 // tRansacModel GenerateRandomIndexSubset
 //----------------------------------------------------------------------
-template <typename TSample>
-void tRansacModel<TSample>::GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const
+template <typename TSample, typename TError>
+void tRansacModel<TSample, TError>::GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const
 {
   index_set.clear();
   index_set.reserve(set_size);
@@ -245,17 +603,156 @@ void tRansacModel<TSample>::GenerateRandomIndexSet(std::vector<size_t> &index_se
   }
 }
 
+//----------------------------------------------------------------------
+// tRansacModel GenerateNextIndexSet
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+bool tRansacModel<TSample, TError>::GenerateNextIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const
+{
+  if (index_set.size() != set_size)
+  {
+    index_set.resize(set_size);
+    for (size_t i = 0; i < set_size; ++i)
+    {
+      index_set[i] = i;
+    }
+    return set_size <= max_index + 1;
+  }
+
+  for (size_t i = set_size; i-- > 0;)
+  {
+    if (index_set[i] < max_index + 1 - set_size + i)
+    {
+      ++index_set[i];
+      for (size_t k = i + 1; k < set_size; ++k)
+      {
+        index_set[k] = index_set[k - 1] + 1;
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------
+// tRansacModel PreferenceDistance
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+double tRansacModel<TSample, TError>::PreferenceDistance(const uint64_t *a, const uint64_t *b, size_t number_of_words)
+{
+  size_t intersection = 0;
+  size_t union_ = 0;
+  for (size_t w = 0; w < number_of_words; ++w)
+  {
+    intersection += PopulationCount(a[w] & b[w]);
+    union_ += PopulationCount(a[w] | b[w]);
+  }
+  return union_ == 0 ? 1.0 : 1.0 - static_cast<double>(intersection) / union_;
+}
+
+template <typename TSample, typename TError>
+double tRansacModel<TSample, TError>::PreferenceDistance(const float *a, const float *b, size_t number_of_hypotheses)
+{
+  double dot_product = 0;
+  double squared_norm_a = 0;
+  double squared_norm_b = 0;
+  for (size_t h = 0; h < number_of_hypotheses; ++h)
+  {
+    dot_product += a[h] * b[h];
+    squared_norm_a += a[h] * a[h];
+    squared_norm_b += b[h] * b[h];
+  }
+  double denominator = squared_norm_a + squared_norm_b - dot_product;
+  return denominator <= 0.0 ? 1.0 : 1.0 - dot_product / denominator;
+}
+
+//----------------------------------------------------------------------
+// tRansacModel GetSampleErrors
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+void tRansacModel<TSample, TError>::GetSampleErrors(std::vector<TError> &errors) const
+{
+  errors.resize(this->samples.size());
+  for (size_t i = 0; i < this->samples.size(); ++i)
+  {
+    errors[i] = this->GetSampleError(this->samples[i]);
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacModel GenerateUnseenRandomIndexSet
+//----------------------------------------------------------------------
+template <typename TSample, typename TError>
+void tRansacModel<TSample, TError>::GenerateUnseenRandomIndexSet(std::vector<size_t> &index_set, std::vector<size_t> &sorted_index_set, size_t max_index,
+    tIndexSetHashSet &evaluated_index_sets) const
+{
+  const size_t max_redraws = cMAX_REDRAWS_PER_INDEX * this->MinimalSetSize();
+  for (size_t redraw = 0; redraw < 2 * max_redraws; ++redraw)
+  {
+    // overrides may reach only a few distinct sets, so the second half of the attempts draws uniformly from all samples
+    if (redraw < max_redraws)
+    {
+      this->GenerateRandomIndexSet(index_set, this->MinimalSetSize(), max_index);
+    }
+    else
+    {
+      tRansacModel::GenerateRandomIndexSet(index_set, this->MinimalSetSize(), max_index);
+    }
+    sorted_index_set = index_set;
+    std::sort(sorted_index_set.begin(), sorted_index_set.end());
+    if (evaluated_index_sets.insert(sorted_index_set).second)
+    {
+      return;
+    }
+  }
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Found no minimal set that has not been evaluated, yet. Evaluating a duplicate.");
+}
+
 //----------------------------------------------------------------------
 // tRansacModel DetermineConsensusIndexSet
 //----------------------------------------------------------------------
-template <typename TSample>
-double tRansacModel<TSample>::DetermineConsensusIndexSet(std::vector<size_t> &consensus_index_set, double max_error) const
+template <typename TSample, typename TError>
+double tRansacModel<TSample, TError>::DetermineConsensusIndexSet(std::vector<size_t> &consensus_index_set, double max_error, double &total_loss) const
 {
   consensus_index_set.clear();
   double total_error = 0.0;
+  total_loss = 0.0;
+
+  if (this->GetCandidateIndexSet(this->candidate_index_set, max_error))
+  {
+    // every sample outside the candidate set has the maximal loss of 1
+    total_loss = this->samples.size() - this->candidate_index_set.size();
+    for (std::vector<size_t>::const_iterator it = this->candidate_index_set.begin(); it != this->candidate_index_set.end(); ++it)
+    {
+      double error = this->GetSampleError(this->samples[*it]);
+      total_loss += this->GetSampleLoss(error, max_error);
+      if (error <= max_error)
+      {
+        total_error += error;
+        consensus_index_set.push_back(*it);
+      }
+    }
+    return total_error;
+  }
+
+  if (this->scoring_policy == tScoringPolicy::INLIER_COUNT && this->GetInlierFlags(this->inlier_flags, max_error, total_error))
+  {
+    for (size_t i = 0; i < this->inlier_flags.size(); ++i)
+    {
+      if (this->inlier_flags[i])
+      {
+        consensus_index_set.push_back(i);
+      }
+    }
+    total_loss = this->samples.size() - consensus_index_set.size();
+    return total_error;
+  }
+
+  this->GetSampleErrors(this->sample_errors);
   for (size_t i = 0; i < this->samples.size(); ++i)
   {
-    double error = this->GetSampleError(this->samples[i]);
+    double error = this->sample_errors[i];
+    total_loss += this->GetSampleLoss(error, max_error);
     if (error <= max_error)
     {
       total_error += error;
@@ -0,0 +1,220 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacOrientedPlane3D.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRansacOrientedPlane3D
+ *
+ * \b tRansacOrientedPlane3D
+ *
+ * A few words for tRansacOrientedPlane3D
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tRansacOrientedPlane3D_h__
+#define __rrlib__model_fitting__tRansacOrientedPlane3D_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include "rrlib/math/tAngle.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/geometry/tPlane.h"
+#include "rrlib/model_fitting/tRansacModel.h"
+#include "rrlib/model_fitting/tPlaneMoments.h"
+#include "rrlib/model_fitting/tOrientedPointShape.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! RANSAC plane model that uses the normals of oriented points
+/*! A single oriented point determines a plane, so the minimal set size is
+    1 instead of 3. The number of iterations that are needed to draw an
+    outlier-free minimal set with a given confidence drops from
+    log(1 - p) / log(1 - w^3) to log(1 - p) / log(1 - w) for inlier ratio w.
+
+    A sample is an inlier if its point is close to the plane and its normal
+    encloses at most the given angle with the plane normal, regardless of
+    its sign. Samples that fail the normal agreement get an infinite error.
+
+    With an active normal constraint, only samples whose own normals satisfy
+    it are drawn as minimal sets. That discards hypotheses before they are
+    scored, as the plane of a single sample has that sample's normal.
+
+    The refit uses the points only, as in tRansacPlane3D. As a
+    tOrientedPointShape, the model is also a shape type of tEfficientRansac.
+*/
+template <typename TElement = double>
+class tRansacOrientedPlane3D : public geometry::tPlane<3, TElement>, public model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement>, public tOrientedPointShape<TElement>
+{
+
+  typedef model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement> tRansacModel;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tOrientedPoint3D<TElement> tSample;
+  typedef typename geometry::tPlane<3, TElement>::tPoint tPoint;
+  typedef model_fitting::tPlaneMoments<TElement> tMoments;
+
+  explicit tRansacOrientedPlane3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization = false);
+
+  template <typename TIterator>
+  tRansacOrientedPlane3D(TIterator begin, TIterator end, math::tAngleRadUnsigned max_normal_angle_distance,
+                         unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
+                         bool local_optimization = false)
+    : tRansacModel(local_optimization),
+      next_candidate(0)
+  {
+    this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+    this->Initialize(std::distance(begin, end));
+    this->AddSamples(begin, end);
+    if (!this->DoRANSAC(max_iterations, satisfactory_support_ratio, max_error))
+    {
+      throw std::runtime_error("Failed to fit RANSAC model during construction!");
+    }
+  }
+
+  template <typename TIterator>
+  tRansacOrientedPlane3D(TIterator begin, TIterator end, math::tAngleRadUnsigned max_normal_angle_distance,
+                         const math::tVector<3, TElement> &normal_constraint_direction, math::tAngleRadUnsigned normal_constraint_max_angle_distance,
+                         unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
+                         bool local_optimization = false)
+    : tRansacModel(local_optimization),
+      next_candidate(0)
+  {
+    this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+    this->Initialize(std::distance(begin, end));
+    this->AddSamples(begin, end);
+    this->SetNormalConstraint(normal_constraint_direction, normal_constraint_max_angle_distance);
+    if (!this->DoRANSAC(max_iterations, satisfactory_support_ratio, max_error))
+    {
+      throw std::runtime_error("Failed to fit RANSAC model during construction!");
+    }
+  }
+
+  virtual tRansacOrientedPlane3D *Clone() const
+  {
+    return new tRansacOrientedPlane3D(*this);
+  }
+
+  const size_t MinimalSetSize() const
+  {
+    return 1;
+  }
+
+  virtual const bool FitToMinimalSamples(const std::vector<tSample> &samples);
+  virtual const bool FitToSamples(const std::vector<tSample> &samples);
+  virtual const TElement GetSampleError(const tSample &sample) const;
+
+  /*!
+   * \brief The maximal angle between the normals of inliers and the plane normal
+   */
+  void SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance);
+
+  void SetNormalConstraint(const math::tVector<3, TElement> &direction, math::tAngleRadUnsigned max_angle_distance);
+
+  void ClearNormalConstraint();
+
+  /*!
+   * \brief Fit to the points whose moments are given, e.g. during region growing
+   *
+   * \return Whether the points determine a plane that satisfies the constraints
+   */
+  const bool UpdateModelFromMoments(const tMoments &moments);
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  struct tNormalConstraint
+  {
+    bool active;
+    math::tVector<3, TElement> direction;
+    math::tAngleRadUnsigned max_angle_distance;
+    TElement min_cosine;
+    tNormalConstraint() : active(false), min_cosine(0) {}
+  } normal_constraint;
+
+  TElement min_normal_cosine;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tRansacOrientedPlane3D";
+  }
+
+  const bool CheckConstraints() const;
+  const bool FitToOrientedPoint(const tSample &sample);
+  const bool SatisfiesNormalConstraint(const tPoint &normal) const;
+
+  virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual void PrepareScoring();
+  virtual void GetSampleErrors(std::vector<TElement> &errors) const;
+  virtual void GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const;
+
+  std::vector<size_t> candidate_indices;
+  mutable size_t next_candidate;
+
+  std::vector<TElement> x_values;
+  std::vector<TElement> y_values;
+  std::vector<TElement> z_values;
+  std::vector<TElement> normal_x_values;
+  std::vector<TElement> normal_y_values;
+  std::vector<TElement> normal_z_values;
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tRansacOrientedPlane3D.hpp"
+
+#endif
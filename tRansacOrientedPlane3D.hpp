@@ -0,0 +1,358 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacOrientedPlane3D.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tRansacOrientedPlane3D<TElement>::tRansacOrientedPlane3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization)
+  : tRansacModel(local_optimization),
+    next_candidate(0)
+{
+  this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D SetMaxNormalAngleDistance
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance)
+{
+  this->min_normal_cosine = std::cos(static_cast<double>(max_angle_distance));
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D SetNormalConstraint
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::SetNormalConstraint(const math::tVector<3, TElement> &direction, math::tAngleRadUnsigned max_angle_distance)
+{
+  this->normal_constraint.active = true;
+  this->normal_constraint.direction = direction.Normalized();
+  this->normal_constraint.max_angle_distance = max_angle_distance;
+  this->normal_constraint.min_cosine = std::cos(static_cast<double>(max_angle_distance));
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D ClearNormalConstraint
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::ClearNormalConstraint()
+{
+  this->normal_constraint.active = false;
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D FitToMinimalSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  return this->FitToOrientedPoint(this->Samples()[sample_index_set[0]]);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D FitToMinimalSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::FitToMinimalSamples(const std::vector<tSample> &samples)
+{
+  assert(!samples.empty());
+  return this->FitToOrientedPoint(samples[0]);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D FitToOrientedPoint
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::FitToOrientedPoint(const tSample &sample)
+{
+  if (sample.normal.IsZero())
+  {
+    return false;
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Using point: ", sample.point, " with normal ", sample.normal);
+  this->Set(sample.point, sample.normal);
+
+  if (this->normal_constraint.active)
+  {
+    if (this->Normal() * this->normal_constraint.direction < 0)
+    {
+      this->Set(this->Support(), -this->Normal());
+    }
+  }
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Checking constraints");
+  if (!this->CheckConstraints())
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Constraints violated!");
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D FitToSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  assert(!sample_index_set.empty());
+
+  tMoments moments;
+  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  {
+    moments.Add(this->Samples()[*it].point);
+  }
+
+  return this->UpdateModelFromMoments(moments);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D FitToSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::FitToSamples(const std::vector<tSample> &samples)
+{
+  tMoments moments;
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    moments.Add(it->point);
+  }
+
+  return this->UpdateModelFromMoments(moments);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D UpdateModelFromMoments
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::UpdateModelFromMoments(const tMoments &moments)
+{
+  if (!moments.GetPlane(*this))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine a plane!");
+    return false;
+  }
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->Support(), ", ", this->Normal(), ")");
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Checking constraints");
+  if (!this->CheckConstraints())
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Constraints violated!");
+    return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D PrepareScoring
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::PrepareScoring()
+{
+  size_t number_of_samples = this->Samples().size();
+  this->x_values.resize(number_of_samples);
+  this->y_values.resize(number_of_samples);
+  this->z_values.resize(number_of_samples);
+  this->normal_x_values.resize(number_of_samples);
+  this->normal_y_values.resize(number_of_samples);
+  this->normal_z_values.resize(number_of_samples);
+
+  this->candidate_indices.clear();
+  for (size_t i = 0; i < number_of_samples; ++i)
+  {
+    const tSample &sample = this->Samples()[i];
+    this->x_values[i] = sample.point.X();
+    this->y_values[i] = sample.point.Y();
+    this->z_values[i] = sample.point.Z();
+
+    // samples without a normal never agree with a plane
+    tPoint normal = sample.normal.IsZero() ? sample.normal : sample.normal.Normalized();
+    this->normal_x_values[i] = normal.X();
+    this->normal_y_values[i] = normal.Y();
+    this->normal_z_values[i] = normal.Z();
+
+    if (!normal.IsZero() && this->SatisfiesNormalConstraint(normal))
+    {
+      this->candidate_indices.push_back(i);
+    }
+  }
+
+  // drawing from a random permutation of the candidates avoids rejected duplicates
+  for (size_t i = this->candidate_indices.size(); i > 1; --i)
+  {
+    std::swap(this->candidate_indices[i - 1], this->candidate_indices[rand() % i]);
+  }
+  this->next_candidate = 0;
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, this->candidate_indices.size(), " of ", number_of_samples, " samples satisfy the normal constraint.");
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D GetSampleErrors
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::GetSampleErrors(std::vector<TElement> &errors) const
+{
+  assert(this->x_values.size() == this->Samples().size());
+
+  const TElement nx = this->Normal().X();
+  const TElement ny = this->Normal().Y();
+  const TElement nz = this->Normal().Z();
+  const TElement d = static_cast<double>(nx) * this->Support().X() + static_cast<double>(ny) * this->Support().Y() + static_cast<double>(nz) * this->Support().Z();
+  const TElement min_cosine = this->min_normal_cosine;
+  const TElement infinity = std::numeric_limits<TElement>::infinity();
+
+  size_t n = this->x_values.size();
+  errors.resize(n);
+  const TElement *__restrict__ x = this->x_values.data();
+  const TElement *__restrict__ y = this->y_values.data();
+  const TElement *__restrict__ z = this->z_values.data();
+  const TElement *__restrict__ normal_x = this->normal_x_values.data();
+  const TElement *__restrict__ normal_y = this->normal_y_values.data();
+  const TElement *__restrict__ normal_z = this->normal_z_values.data();
+  TElement *__restrict__ e = errors.data();
+  for (size_t i = 0; i < n; ++i)
+  {
+    TElement distance = std::fabs(nx * x[i] + ny * y[i] + nz * z[i] - d);
+    TElement cosine = std::fabs(nx * normal_x[i] + ny * normal_y[i] + nz * normal_z[i]);
+    e[i] = cosine >= min_cosine ? distance : infinity;
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D GenerateRandomIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacOrientedPlane3D<TElement>::GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const
+{
+  assert(set_size == 1);
+
+  // once all candidates were drawn, fall back to all samples, which are rejected by the constraints if necessary
+  if (this->next_candidate < this->candidate_indices.size() && this->candidate_indices[this->next_candidate] <= max_index)
+  {
+    index_set.assign(1, this->candidate_indices[this->next_candidate++]);
+    return;
+  }
+  tRansacModel::GenerateRandomIndexSet(index_set, set_size, max_index);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D GetSampleError
+//----------------------------------------------------------------------
+template <typename TElement>
+const TElement tRansacOrientedPlane3D<TElement>::GetSampleError(const tSample &sample) const
+{
+  if (sample.normal.IsZero() || std::fabs(this->Normal() * sample.normal.Normalized()) < this->min_normal_cosine)
+  {
+    return std::numeric_limits<TElement>::infinity();
+  }
+  return this->GetDistanceToPoint(sample.point);
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D SatisfiesNormalConstraint
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::SatisfiesNormalConstraint(const tPoint &normal) const
+{
+  // normals of single points are often oriented towards the sensor, so only the line through them matters here
+  return !this->normal_constraint.active || std::fabs(normal * this->normal_constraint.direction) >= this->normal_constraint.min_cosine;
+}
+
+//----------------------------------------------------------------------
+// tRansacOrientedPlane3D CheckConstraints
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacOrientedPlane3D<TElement>::CheckConstraints() const
+{
+  if (this->normal_constraint.active)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Checking normal constraint:");
+
+    if (EnclosedAngle(this->Normal(), this->normal_constraint.direction) > rrlib::math::tAngleRad(this->normal_constraint.max_angle_distance))
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Failed!");
+      return false;
+    }
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "OK.");
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
@@ -38,7 +38,6 @@
 #define __rrlib__model_fitting__tRansacPlane3D_h__
 
 #include "rrlib/geometry/tPlane.h"
-#include "rrlib/model_fitting/tRansacModel.h"
 //----------------------------------------------------------------------
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
@@ -47,6 +46,9 @@
 //----------------------------------------------------------------------
 // Internal includes with ""
 //----------------------------------------------------------------------
+#include "rrlib/model_fitting/tRansacModel.h"
+#include "rrlib/model_fitting/tPlaneMoments.h"
+#include "rrlib/model_fitting/tPointOctree.h"
 
 //----------------------------------------------------------------------
 // Debugging
@@ -70,12 +72,17 @@ namespace model_fitting
 //! Short description of tRansacPlane3D
 /*! A more detailed description of tRansacPlane3D, which
     Tobias Foehst hasn't done yet !!
+
+    Samples, constraints and per-sample errors are of type TElement, so
+    that float halves the bandwidth of scoring. The moments for refits
+    are accumulated in double, as second moments cancel in single
+    precision.
 */
 template <typename TElement = double>
-class tRansacPlane3D : public geometry::tPlane<3, TElement>, public model_fitting::tRansacModel<typename geometry::tPlane<3, TElement>::tPoint>
+class tRansacPlane3D : public geometry::tPlane<3, TElement>, public model_fitting::tRansacModel<typename geometry::tPlane<3, TElement>::tPoint, TElement>
 {
 
-  typedef model_fitting::tRansacModel<typename geometry::tPlane<3, TElement>::tPoint> tRansacModel;
+  typedef model_fitting::tRansacModel<typename geometry::tPlane<3, TElement>::tPoint, TElement> tRansacModel;
 
 //----------------------------------------------------------------------
 // Public methods and typedefs
@@ -83,6 +90,7 @@ class tRansacPlane3D : public geometry::tPlane<3, TElement>, public model_fittin
 public:
 
   typedef typename geometry::tPlane<3, TElement>::tPoint tSample;
+  typedef model_fitting::tPlaneMoments<TElement> tMoments;
 
   explicit tRansacPlane3D(bool local_optimization = false);
 
@@ -90,7 +98,11 @@ public:
   tRansacPlane3D(TIterator begin, TIterator end,
                  unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
                  bool local_optimization = false)
-    : tRansacModel(local_optimization)
+    : tRansacModel(local_optimization),
+      image_width(0),
+      image_height(0),
+      sampling_window_radius(32),
+      spatial_index(NULL)
   {
     this->Initialize(std::distance(begin, end));
     this->AddSamples(begin, end);
@@ -102,10 +114,14 @@ public:
 
   template <typename TIterator>
   tRansacPlane3D(TIterator begin, TIterator end,
-                 const math::tVec3d &normal_constraint_direction, math::tAngleRadUnsigned normal_constraint_max_angle_distance,
+                 const math::tVector<3, TElement> &normal_constraint_direction, math::tAngleRadUnsigned normal_constraint_max_angle_distance,
                  unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
                  bool local_optimization = false)
-    : tRansacModel(local_optimization)
+    : tRansacModel(local_optimization),
+      image_width(0),
+      image_height(0),
+      sampling_window_radius(32),
+      spatial_index(NULL)
   {
     this->Initialize(std::distance(begin, end));
     this->AddSamples(begin, end);
@@ -118,10 +134,14 @@ public:
 
   template <typename TIterator>
   tRansacPlane3D(TIterator begin, TIterator end,
-                 const geometry::tPlane3D::tPoint &point_constraint_reference_point, double point_constraint_min_distance, double point_constraint_max_distance,
+                 const typename geometry::tPlane<3, TElement>::tPoint &point_constraint_reference_point, TElement point_constraint_min_distance, TElement point_constraint_max_distance,
                  unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
                  bool local_optimization = false)
-    : tRansacModel(local_optimization)
+    : tRansacModel(local_optimization),
+      image_width(0),
+      image_height(0),
+      sampling_window_radius(32),
+      spatial_index(NULL)
   {
     this->Initialize(std::distance(begin, end));
     this->AddSamples(begin, end);
@@ -134,11 +154,15 @@ public:
 
   template <typename TIterator>
   tRansacPlane3D(TIterator begin, TIterator end,
-                 const math::tVec3d &normal_constraint_direction, math::tAngleRadUnsigned normal_constraint_max_angle_distance,
-                 const geometry::tPlane3D::tPoint &point_constraint_reference_point, double point_constraint_min_distance, double point_constraint_max_distance,
+                 const math::tVector<3, TElement> &normal_constraint_direction, math::tAngleRadUnsigned normal_constraint_max_angle_distance,
+                 const typename geometry::tPlane<3, TElement>::tPoint &point_constraint_reference_point, TElement point_constraint_min_distance, TElement point_constraint_max_distance,
                  unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
                  bool local_optimization = false)
-    : tRansacModel(local_optimization)
+    : tRansacModel(local_optimization),
+      image_width(0),
+      image_height(0),
+      sampling_window_radius(32),
+      spatial_index(NULL)
   {
     this->Initialize(std::distance(begin, end));
     this->AddSamples(begin, end);
@@ -155,14 +179,87 @@ public:
     return 3;
   }
 
-  void SetNormalConstraint(const math::tVec3d &direction, math::tAngleRadUnsigned max_angle_distance);
+  void SetNormalConstraint(const math::tVector<3, TElement> &direction, math::tAngleRadUnsigned max_angle_distance);
 
-  void SetPointConstraint(const geometry::tPlane3D::tPoint &reference_point, double min_distance, double max_distance);
+  void SetPointConstraint(const tSample &reference_point, TElement min_distance, TElement max_distance);
 
   void ClearNormalConstraint();
 
   void ClearPointConstraint();
 
+  /*!
+   * \brief Fit to the points whose moments are given, e.g. during region growing
+   *
+   * \return Whether the points determine a plane that satisfies the constraints
+   */
+  const bool UpdateModelFromMoments(const tMoments &moments);
+
+  /*!
+   * \brief Score hypotheses only on the samples in octree cells that intersect their slab of inliers
+   *
+   * The octree must be built over the samples in the same order, e.g.
+   * from Samples(), and outlive all calls to DoRANSAC. Pass NULL to score
+   * all samples again. For large static clouds that are fitted
+   * repeatedly, this makes the cost of a hypothesis proportional to its
+   * support instead of the number of samples.
+   */
+  inline void SetSpatialIndex(const tPointOctree<TElement> *spatial_index)
+  {
+    this->spatial_index = spatial_index;
+  }
+
+  /*!
+   * \brief Use an organized point cloud, e.g. from a depth image, as samples
+   *
+   * Replaces all samples by the valid pixels in row-major order. Pixels
+   * with non-finite coordinates (e.g. NaN for missing depth) or a zero
+   * entry in the valid mask are skipped. Adding further samples ends the
+   * organized mode.
+   *
+   * The valid points are copied into Samples() and, when scoring starts,
+   * into the contiguous coordinate arrays of GetSampleErrors. The points
+   * are not read from the buffer directly, because tRansacModel fits,
+   * scores and reports assignments by sample index. The copy costs one
+   * pass over the image per call, and in return scoring skips invalid
+   * pixels. The pixel index maps only translate between samples and
+   * pixels for window sampling and GetInlierMask. The buffer need not
+   * outlive this call.
+   *
+   * \param points       width * height points in row-major order
+   * \param width        The width of the image
+   * \param height       The height of the image
+   * \param valid_mask   Optional width * height flags, zero for invalid pixels
+   */
+  template <typename TPoint>
+  void SetOrganizedSamples(const TPoint *points, size_t width, size_t height, const unsigned char *valid_mask = NULL);
+
+  /*!
+   * \brief Draw the minimal sets of organized samples from square pixel windows
+   *
+   * The first point is drawn from all valid pixels, the others from the
+   * window of the given radius around it. Nearby pixels are much more
+   * likely to lie on the same plane, but too small windows yield poorly
+   * conditioned triples for noisy depth. A radius of 0 draws from all
+   * pixels. The default is 32.
+   */
+  inline void SetSamplingWindowRadius(size_t radius)
+  {
+    this->sampling_window_radius = radius;
+  }
+
+  inline bool IsOrganized() const
+  {
+    return this->image_width > 0;
+  }
+
+  /*!
+   * \brief The inliers of the current model as an image of the organized samples
+   *
+   * \param mask            width * height flags in row-major order
+   * \param inlier_value    The value of inlier pixels, all others are zero
+   */
+  void GetInlierMask(std::vector<unsigned char> &mask, unsigned char inlier_value = 255) const;
+
 //----------------------------------------------------------------------
 // Private fields and methods
 //----------------------------------------------------------------------
@@ -171,7 +268,7 @@ private:
   struct tNormalConstraint
   {
     bool active;
-    math::tVec3d direction;
+    math::tVector<3, TElement> direction;
     math::tAngleRadUnsigned max_angle_distance;
     tNormalConstraint() : active(false) {}
   } normal_constraint;
@@ -180,8 +277,8 @@ private:
   {
     bool active;
     tSample reference_point;
-    double min_distance;
-    double max_distance;
+    TElement min_distance;
+    TElement max_distance;
     tPointConstraint() : active(false) {}
   } point_constraint;
 
@@ -194,7 +291,27 @@ private:
 
   virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
   virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
-  virtual const double GetSampleError(const tSample &sample) const;
+  virtual const TElement GetSampleError(const tSample &sample) const;
+  virtual void PrepareScoring();
+  virtual void GetSampleErrors(std::vector<TElement> &errors) const;
+  virtual void GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const;
+  virtual const bool GetCandidateIndexSet(std::vector<size_t> &candidate_index_set, double max_error) const;
+  virtual void SamplesChanged();
+
+  size_t image_width;
+  size_t image_height;
+  size_t sampling_window_radius;
+  const tPointOctree<TElement> *spatial_index;
+  std::vector<size_t> sample_pixels;
+  std::vector<size_t> pixel_samples;
+
+  std::vector<TElement> x_values;
+  std::vector<TElement> y_values;
+  std::vector<TElement> z_values;
+
+  tMoments fitted_moments;
+  std::vector<size_t> fitted_sample_index_set;
+  std::vector<unsigned char> sample_index_flags;
 
 };
 
@@ -33,9 +33,10 @@
 // External includes (system with <>, local with "")
 //----------------------------------------------------------------------
 #include <vector>
-#include <cv.h>
-
-#include "rrlib/util/join.h"
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <algorithm>
 
 #include "rrlib/logging/messages.h"
 
@@ -77,14 +78,18 @@ namespace model_fitting
 //----------------------------------------------------------------------
 template <typename TElement>
 tRansacPlane3D<TElement>::tRansacPlane3D(bool local_optimization)
-  : tRansacModel(local_optimization)
+  : tRansacModel(local_optimization),
+    image_width(0),
+    image_height(0),
+    sampling_window_radius(32),
+    spatial_index(NULL)
 {}
 
 //----------------------------------------------------------------------
 // tRansacPlane3D SetNormalConstraint
 //----------------------------------------------------------------------
 template <typename TElement>
-void tRansacPlane3D<TElement>::SetNormalConstraint(const math::tVec3d &direction, math::tAngleRadUnsigned max_angle_distance)
+void tRansacPlane3D<TElement>::SetNormalConstraint(const math::tVector<3, TElement> &direction, math::tAngleRadUnsigned max_angle_distance)
 {
   this->normal_constraint.active = true;
   this->normal_constraint.direction = direction.Normalized();
@@ -95,7 +100,7 @@ void tRansacPlane3D<TElement>::SetNormalConstraint(const math::tVec3d &direction
 // tRansacPlane3D SetPointConstraint
 //----------------------------------------------------------------------
 template <typename TElement>
-void tRansacPlane3D<TElement>::SetPointConstraint(const geometry::tPlane3D::tPoint &reference_point, double min_distance, double max_distance)
+void tRansacPlane3D<TElement>::SetPointConstraint(const tSample &reference_point, TElement min_distance, TElement max_distance)
 {
   this->point_constraint.active = true;
   this->point_constraint.reference_point = reference_point;
@@ -121,6 +126,74 @@ void tRansacPlane3D<TElement>::ClearPointConstraint()
   this->point_constraint.active = false;
 }
 
+//----------------------------------------------------------------------
+// tRansacPlane3D SetOrganizedSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+template <typename TPoint>
+void tRansacPlane3D<TElement>::SetOrganizedSamples(const TPoint *points, size_t width, size_t height, const unsigned char *valid_mask)
+{
+  std::vector<tSample> samples;
+  std::vector<size_t> sample_pixels;
+  std::vector<size_t> pixel_samples(width * height, std::numeric_limits<size_t>::max());
+  samples.reserve(width * height);
+  sample_pixels.reserve(width * height);
+
+  for (size_t pixel = 0; pixel < width * height; ++pixel)
+  {
+    const TPoint &point = points[pixel];
+    if ((valid_mask && !valid_mask[pixel]) || !std::isfinite(point.X()) || !std::isfinite(point.Y()) || !std::isfinite(point.Z()))
+    {
+      continue;
+    }
+    pixel_samples[pixel] = sample_pixels.size();
+    sample_pixels.push_back(pixel);
+    samples.push_back(tSample(point.X(), point.Y(), point.Z()));
+  }
+
+  // replacing the samples ends any previous organized mode, so the new one starts afterwards
+  this->Initialize(samples.size());
+  this->AddSamples(samples.begin(), samples.end());
+  this->image_width = width;
+  this->image_height = height;
+  this->sample_pixels.swap(sample_pixels);
+  this->pixel_samples.swap(pixel_samples);
+
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Using ", this->sample_pixels.size(), " valid pixels of ", width, "x", height, " image.");
+}
+
+//----------------------------------------------------------------------
+// tRansacPlane3D SamplesChanged
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacPlane3D<TElement>::SamplesChanged()
+{
+  this->image_width = 0;
+  this->image_height = 0;
+  this->sample_pixels.clear();
+  this->pixel_samples.clear();
+  this->fitted_moments.Clear();
+  this->fitted_sample_index_set.clear();
+}
+
+//----------------------------------------------------------------------
+// tRansacPlane3D GetInlierMask
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacPlane3D<TElement>::GetInlierMask(std::vector<unsigned char> &mask, unsigned char inlier_value) const
+{
+  assert(this->IsOrganized());
+  mask.assign(this->image_width * this->image_height, 0);
+  const std::vector<bool> &assignments = this->Assignments();
+  for (size_t i = 0; i < assignments.size(); ++i)
+  {
+    if (assignments[i])
+    {
+      mask[this->sample_pixels[i]] = inlier_value;
+    }
+  }
+}
+
 //----------------------------------------------------------------------
 // tRansacPlane3D FitToMinimalSampleIndexSet
 //----------------------------------------------------------------------
@@ -175,45 +248,80 @@ const bool tRansacPlane3D<TElement>::FitToMinimalSampleIndexSet(const std::vecto
 template <typename TElement>
 const bool tRansacPlane3D<TElement>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
 {
-  // perform PCA
-  typename geometry::tPlane<3, TElement>::tPoint center_of_gravity;
-  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  assert(!sample_index_set.empty());
+
+  // local optimization and the final refit often change the previous consensus set by a few samples only
+  bool incremental = !this->fitted_sample_index_set.empty() && this->sample_index_flags.size() == this->Samples().size();
+  if (incremental)
   {
-    center_of_gravity += this->Samples()[*it];
-    RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Using sample ", this->Samples()[*it]);
-  }
-  center_of_gravity /= sample_index_set.size();
+    enum { cPREVIOUS = 1, cCURRENT = 2 };
+    for (std::vector<size_t>::const_iterator it = this->fitted_sample_index_set.begin(); it != this->fitted_sample_index_set.end(); ++it)
+    {
+      this->sample_index_flags[*it] |= cPREVIOUS;
+    }
+    for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+    {
+      this->sample_index_flags[*it] |= cCURRENT;
+    }
+
+    size_t number_of_changes = 0;
+    for (std::vector<size_t>::const_iterator it = this->fitted_sample_index_set.begin(); it != this->fitted_sample_index_set.end(); ++it)
+    {
+      number_of_changes += this->sample_index_flags[*it] == cPREVIOUS;
+    }
+    for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+    {
+      number_of_changes += this->sample_index_flags[*it] == cCURRENT;
+    }
 
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Center of gravity: ", center_of_gravity);
+    // rebuild if most samples changed, which also bounds the accumulated rounding errors of removals
+    incremental = 2 * number_of_changes < sample_index_set.size();
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Consensus set changed by ", number_of_changes, " samples");
 
-  double covariance[9];
-  std::memset(covariance, 0, sizeof(covariance));
-  CvMat cv_covariance = cvMat(3, 3, CV_64FC1, covariance);
-  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
-  {
-    tSample centered_point = this->Samples()[*it] - center_of_gravity;
-
-    covariance[0] += centered_point.X() * centered_point.X();
-    covariance[1] = covariance[3] += centered_point.X() * centered_point.Y();
-    covariance[2] = covariance[6] += centered_point.X() * centered_point.Z();
-    covariance[4] += centered_point.Y() * centered_point.Y();
-    covariance[5] = covariance[7] += centered_point.Y() * centered_point.Z();
-    covariance[8] += centered_point.Z() * centered_point.Z();
+    for (std::vector<size_t>::const_iterator it = this->fitted_sample_index_set.begin(); it != this->fitted_sample_index_set.end(); ++it)
+    {
+      if (incremental && this->sample_index_flags[*it] == cPREVIOUS)
+      {
+        this->fitted_moments.Remove(this->Samples()[*it]);
+      }
+      this->sample_index_flags[*it] = 0;
+    }
+    for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+    {
+      if (incremental && this->sample_index_flags[*it] == cCURRENT)
+      {
+        this->fitted_moments.Add(this->Samples()[*it]);
+      }
+      this->sample_index_flags[*it] = 0;
+    }
   }
 
-  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Covariance matrix: [ ", util::Join(covariance, covariance + 9, ", "), "]");
-
-  double s[9];
-  double u[9];
-  CvMat cv_s = cvMat(3, 3, CV_64FC1, s);
-  CvMat cv_u = cvMat(3, 3, CV_64FC1, u);
-  cvSVD(&cv_covariance, &cv_s, &cv_u, 0, CV_SVD_MODIFY_A | CV_SVD_U_T);
+  if (!incremental)
+  {
+    this->fitted_moments.Clear();
+    for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+    {
+      RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Using sample ", this->Samples()[*it]);
+      this->fitted_moments.Add(this->Samples()[*it]);
+    }
+  }
+  this->fitted_sample_index_set = sample_index_set;
 
-  // use weakest component as plane normal
-  math::tVec3d normal(u[6], u[7], u[8]);
+  return this->UpdateModelFromMoments(this->fitted_moments);
+}
 
-  // the current normal was checked against the constraints. maybe the normal from the SVD changed its direction
-  this->Set(center_of_gravity, normal * this->Normal() < 0 ? -normal : normal);
+//----------------------------------------------------------------------
+// tRansacPlane3D UpdateModelFromMoments
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacPlane3D<TElement>::UpdateModelFromMoments(const tMoments &moments)
+{
+  // the current normal was checked against the constraints. maybe the normal from the eigen decomposition changed its direction
+  if (!moments.GetPlane(*this))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine a plane!");
+    return false;
+  }
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->Support(), ", ", this->Normal(), ")");
 
   RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Checking constraints");
@@ -226,11 +334,114 @@ const bool tRansacPlane3D<TElement>::FitToSampleIndexSet(const std::vector<size_
   return true;
 }
 
+//----------------------------------------------------------------------
+// tRansacPlane3D PrepareScoring
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacPlane3D<TElement>::PrepareScoring()
+{
+  this->fitted_moments.Clear();
+  this->fitted_sample_index_set.clear();
+  this->sample_index_flags.assign(this->Samples().size(), 0);
+
+  this->x_values.resize(this->Samples().size());
+  this->y_values.resize(this->Samples().size());
+  this->z_values.resize(this->Samples().size());
+  for (size_t i = 0; i < this->Samples().size(); ++i)
+  {
+    this->x_values[i] = this->Samples()[i].X();
+    this->y_values[i] = this->Samples()[i].Y();
+    this->z_values[i] = this->Samples()[i].Z();
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacPlane3D GetSampleErrors
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacPlane3D<TElement>::GetSampleErrors(std::vector<TElement> &errors) const
+{
+  assert(this->x_values.size() == this->Samples().size());
+
+  // |n * p - n * s| over contiguous coordinates, which are in row-major pixel order for organized samples
+  const TElement nx = this->Normal().X();
+  const TElement ny = this->Normal().Y();
+  const TElement nz = this->Normal().Z();
+  const TElement d = static_cast<double>(nx) * this->Support().X() + static_cast<double>(ny) * this->Support().Y() + static_cast<double>(nz) * this->Support().Z();
+
+  size_t n = this->x_values.size();
+  errors.resize(n);
+  const TElement *__restrict__ x = this->x_values.data();
+  const TElement *__restrict__ y = this->y_values.data();
+  const TElement *__restrict__ z = this->z_values.data();
+  TElement *__restrict__ e = errors.data();
+  for (size_t i = 0; i < n; ++i)
+  {
+    e[i] = std::fabs(nx * x[i] + ny * y[i] + nz * z[i] - d);
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacPlane3D GenerateRandomIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacPlane3D<TElement>::GenerateRandomIndexSet(std::vector<size_t> &index_set, size_t set_size, size_t max_index) const
+{
+  if (!this->IsOrganized() || this->sampling_window_radius == 0)
+  {
+    tRansacModel::GenerateRandomIndexSet(index_set, set_size, max_index);
+    return;
+  }
+
+  index_set.clear();
+  index_set.reserve(set_size);
+  index_set.push_back(rand() % (max_index + 1));
+
+  size_t center_x = this->sample_pixels[index_set.front()] % this->image_width;
+  size_t center_y = this->sample_pixels[index_set.front()] / this->image_width;
+  size_t min_x = center_x > this->sampling_window_radius ? center_x - this->sampling_window_radius : 0;
+  size_t min_y = center_y > this->sampling_window_radius ? center_y - this->sampling_window_radius : 0;
+  size_t window_width = std::min(center_x + this->sampling_window_radius + 1, this->image_width) - min_x;
+  size_t window_height = std::min(center_y + this->sampling_window_radius + 1, this->image_height) - min_y;
+
+  // windows with too few valid pixels fall back to global sampling after a bounded number of attempts
+  for (size_t attempt = 0; attempt < 4 * window_width * window_height && index_set.size() < set_size; ++attempt)
+  {
+    size_t pixel = (min_y + rand() % window_height) * this->image_width + min_x + rand() % window_width;
+    size_t index = this->pixel_samples[pixel];
+    if (index <= max_index && std::find(index_set.begin(), index_set.end(), index) == index_set.end())
+    {
+      index_set.push_back(index);
+    }
+  }
+  if (index_set.size() < set_size)
+  {
+    tRansacModel::GenerateRandomIndexSet(index_set, set_size, max_index);
+  }
+}
+
+//----------------------------------------------------------------------
+// tRansacPlane3D GetCandidateIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacPlane3D<TElement>::GetCandidateIndexSet(std::vector<size_t> &candidate_index_set, double max_error) const
+{
+  if (!this->spatial_index)
+  {
+    return false;
+  }
+  assert(this->spatial_index->NumberOfPoints() == this->Samples().size());
+
+  TElement distance = this->Normal() * this->Support();
+  this->spatial_index->GetSlabPointIndices(this->Normal(), distance, max_error, candidate_index_set);
+  return true;
+}
+
 //----------------------------------------------------------------------
 // tRansacPlane3D GetSampleError
 //----------------------------------------------------------------------
 template <typename TElement>
-const double tRansacPlane3D<TElement>::GetSampleError(const tSample &sample) const
+const TElement tRansacPlane3D<TElement>::GetSampleError(const tSample &sample) const
 {
   return this->GetDistanceToPoint(sample);
 }
@@ -0,0 +1,172 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacSphere3D.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tRansacSphere3D
+ *
+ * \b tRansacSphere3D
+ *
+ * A few words for tRansacSphere3D
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tRansacSphere3D_h__
+#define __rrlib__model_fitting__tRansacSphere3D_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tAngle.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tRansacModel.h"
+#include "rrlib/model_fitting/tOrientedPointShape.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! RANSAC sphere model for oriented points
+/*! Two oriented points determine a sphere: its center is the point
+    closest to both normal lines. A sample is an inlier if its distance
+    to the surface is small and its normal encloses at most the given
+    angle with the surface normal, regardless of its sign.
+
+    The refit minimizes the algebraic distance |p - c|^2 - r^2, which is
+    linear in the parameters.
+*/
+template <typename TElement = double>
+class tRansacSphere3D : public model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement>, public tOrientedPointShape<TElement>
+{
+
+  typedef model_fitting::tRansacModel<tOrientedPoint3D<TElement>, TElement> tRansacModel;
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef tOrientedPoint3D<TElement> tSample;
+  typedef typename tSample::tPoint tPoint;
+
+  explicit tRansacSphere3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization = false);
+
+  template <typename TIterator>
+  tRansacSphere3D(TIterator begin, TIterator end, math::tAngleRadUnsigned max_normal_angle_distance,
+                  unsigned int max_iterations = 50, double satisfactory_support_ratio = 1.0, double max_error = 1E-6,
+                  bool local_optimization = false)
+    : tRansacModel(local_optimization),
+      radius(0)
+  {
+    this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+    this->Initialize(std::distance(begin, end));
+    this->AddSamples(begin, end);
+    if (!this->DoRANSAC(max_iterations, satisfactory_support_ratio, max_error))
+    {
+      throw std::runtime_error("Failed to fit RANSAC model during construction!");
+    }
+  }
+
+  virtual tRansacSphere3D *Clone() const
+  {
+    return new tRansacSphere3D(*this);
+  }
+
+  const size_t MinimalSetSize() const
+  {
+    return 2;
+  }
+
+  inline const tPoint &Center() const
+  {
+    return this->center;
+  }
+
+  inline TElement Radius() const
+  {
+    return this->radius;
+  }
+
+  /*!
+   * \brief The maximal angle between the normals of inliers and the surface normal
+   */
+  void SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance);
+
+  virtual const bool FitToMinimalSamples(const std::vector<tSample> &samples);
+  virtual const bool FitToSamples(const std::vector<tSample> &samples);
+  virtual const TElement GetSampleError(const tSample &sample) const;
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  tPoint center;
+  TElement radius;
+
+  TElement min_normal_cosine;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tRansacSphere3D";
+  }
+
+  const bool FitToOrientedPoints(const tSample &a, const tSample &b);
+  const bool CheckNormalAgreement(const tSample &sample) const;
+
+  virtual const bool FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set);
+  virtual const bool FitToSampleIndexSet(const std::vector<size_t> &sample_index_set);
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tRansacSphere3D.hpp"
+
+#endif
@@ -0,0 +1,238 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tRansacSphere3D.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/gaussian_elimination.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tRansacSphere3D constructors
+//----------------------------------------------------------------------
+template <typename TElement>
+tRansacSphere3D<TElement>::tRansacSphere3D(math::tAngleRadUnsigned max_normal_angle_distance, bool local_optimization)
+  : tRansacModel(local_optimization),
+    radius(0)
+{
+  this->SetMaxNormalAngleDistance(max_normal_angle_distance);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D SetMaxNormalAngleDistance
+//----------------------------------------------------------------------
+template <typename TElement>
+void tRansacSphere3D<TElement>::SetMaxNormalAngleDistance(math::tAngleRadUnsigned max_angle_distance)
+{
+  this->min_normal_cosine = std::cos(static_cast<double>(max_angle_distance));
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D FitToMinimalSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::FitToMinimalSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  return this->FitToOrientedPoints(this->Samples()[sample_index_set[0]], this->Samples()[sample_index_set[1]]);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D FitToMinimalSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::FitToMinimalSamples(const std::vector<tSample> &samples)
+{
+  assert(samples.size() >= 2);
+  return this->FitToOrientedPoints(samples[0], samples[1]);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D FitToSampleIndexSet
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::FitToSampleIndexSet(const std::vector<size_t> &sample_index_set)
+{
+  std::vector<tSample> samples;
+  samples.reserve(sample_index_set.size());
+  for (std::vector<size_t>::const_iterator it = sample_index_set.begin(); it != sample_index_set.end(); ++it)
+  {
+    samples.push_back(this->Samples()[*it]);
+  }
+  return this->FitToSamples(samples);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D FitToOrientedPoints
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::FitToOrientedPoints(const tSample &a, const tSample &b)
+{
+  // closest points of the lines a.point + s * a.normal and b.point + t * b.normal
+  tPoint w = a.point - b.point;
+  double aa = a.normal * a.normal;
+  double ab = a.normal * b.normal;
+  double bb = b.normal * b.normal;
+  double aw = a.normal * w;
+  double bw = b.normal * w;
+  double denominator = aa * bb - ab * ab;
+  if (denominator <= 1E-12 * aa * bb)
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Normal lines are parallel.");
+    return false;
+  }
+  double s = (ab * bw - bb * aw) / denominator;
+  double t = (aa * bw - ab * aw) / denominator;
+
+  this->center = 0.5 * (a.point + s * a.normal + b.point + t * b.normal);
+  this->radius = 0.5 * ((a.point - this->center).Length() + (b.point - this->center).Length());
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "Sphere: (", this->center, ", ", this->radius, ")");
+
+  return this->radius > 0 && this->CheckNormalAgreement(a) && this->CheckNormalAgreement(b);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D FitToSamples
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::FitToSamples(const std::vector<tSample> &samples)
+{
+  if (samples.size() < 4)
+  {
+    return false;
+  }
+
+  // |q|^2 + g * q + h = 0 with q = p - mean for conditioning
+  double mean[3] = { 0, 0, 0 };
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    mean[0] += it->point.X();
+    mean[1] += it->point.Y();
+    mean[2] += it->point.Z();
+  }
+  for (size_t k = 0; k < 3; ++k)
+  {
+    mean[k] /= samples.size();
+  }
+
+  double a[4][4] = {};
+  double b[4] = {};
+  for (typename std::vector<tSample>::const_iterator it = samples.begin(); it != samples.end(); ++it)
+  {
+    double row[4] = { it->point.X() - mean[0], it->point.Y() - mean[1], it->point.Z() - mean[2], 1 };
+    double square_length = row[0] * row[0] + row[1] * row[1] + row[2] * row[2];
+    for (size_t i = 0; i < 4; ++i)
+    {
+      for (size_t j = 0; j < 4; ++j)
+      {
+        a[i][j] += row[i] * row[j];
+      }
+      b[i] -= row[i] * square_length;
+    }
+  }
+  if (!SolveLinearSystem(a, b))
+  {
+    RRLIB_LOG_PRINT(DEBUG_VERBOSE_1, "Samples do not determine a sphere!");
+    return false;
+  }
+
+  double square_radius = 0.25 * (b[0] * b[0] + b[1] * b[1] + b[2] * b[2]) - b[3];
+  if (square_radius <= 0)
+  {
+    return false;
+  }
+  this->center = tPoint(mean[0] - 0.5 * b[0], mean[1] - 0.5 * b[1], mean[2] - 0.5 * b[2]);
+  this->radius = std::sqrt(square_radius);
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_3, "After fitting: (", this->center, ", ", this->radius, ")");
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D GetSampleError
+//----------------------------------------------------------------------
+template <typename TElement>
+const TElement tRansacSphere3D<TElement>::GetSampleError(const tSample &sample) const
+{
+  if (!this->CheckNormalAgreement(sample))
+  {
+    return std::numeric_limits<TElement>::infinity();
+  }
+  return std::fabs((sample.point - this->center).Length() - this->radius);
+}
+
+//----------------------------------------------------------------------
+// tRansacSphere3D CheckNormalAgreement
+//----------------------------------------------------------------------
+template <typename TElement>
+const bool tRansacSphere3D<TElement>::CheckNormalAgreement(const tSample &sample) const
+{
+  tPoint radial = sample.point - this->center;
+  return std::fabs(sample.normal * radial) >= this->min_normal_cosine * sample.normal.Length() * radial.Length() && !radial.IsZero() && !sample.normal.IsZero();
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
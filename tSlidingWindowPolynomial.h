@@ -0,0 +1,206 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tSlidingWindowPolynomial.h
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ * \brief   Contains tSlidingWindowPolynomial
+ *
+ * \b tSlidingWindowPolynomial
+ *
+ * Streaming least squares polynomial fit over the last N samples of a
+ * signal.
+ *
+ */
+//----------------------------------------------------------------------
+#ifndef __rrlib__model_fitting__tSlidingWindowPolynomial_h__
+#define __rrlib__model_fitting__tSlidingWindowPolynomial_h__
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <vector>
+
+#include "rrlib/math/tVector.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tLeastSquaresPolynomial.h"
+#include "rrlib/model_fitting/tPolynomialMoments.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Class declaration
+//----------------------------------------------------------------------
+//! Least squares polynomial over a sliding window of streamed samples
+/*! Keeps the last Capacity() samples in a ring buffer together with their
+ *  power sums, so that pushing a sample costs O(Tdegree) and the normal
+ *  equations are only solved when Solve() is called.
+ *
+ *  The power sums are accumulated for x relative to an origin in the
+ *  window and scaled by half the window width, which keeps the normal
+ *  matrix well-conditioned for drifting x and for long or short windows.
+ *  Once per Capacity() updates, or as soon as new samples leave the
+ *  scaled range or the window shrinks far below it, the sums are rebuilt
+ *  from the buffer around a new origin and scale. This also discards
+ *  rounding errors accumulated by adding and removing samples. The
+ *  fitted polynomial is expressed relative to the origin, use operator()
+ *  to evaluate it at an absolute x.
+ */
+template <size_t Tdegree>
+class tSlidingWindowPolynomial
+{
+
+//----------------------------------------------------------------------
+// Public methods and typedefs
+//----------------------------------------------------------------------
+public:
+
+  typedef math::tVec2d tSample;
+
+  explicit tSlidingWindowPolynomial(size_t capacity);
+
+  void Clear();
+
+  /*!
+   * \brief Add a sample, dropping the oldest one if the window is full
+   */
+  void Push(const tSample &sample);
+
+  /*!
+   * \brief Drop the oldest sample
+   */
+  void Pop();
+
+  inline size_t Size() const
+  {
+    return this->size;
+  }
+
+  inline size_t Capacity() const
+  {
+    return this->buffer.size();
+  }
+
+  inline const tSample &Oldest() const
+  {
+    assert(this->size > 0);
+    return this->buffer[this->head];
+  }
+
+  inline const tSample &Newest() const
+  {
+    assert(this->size > 0);
+    return this->buffer[(this->head + this->size - 1) % this->buffer.size()];
+  }
+
+  /*!
+   * \brief Fit the polynomial to the current window
+   *
+   * \return Whether the normal equations could be solved
+   */
+  const bool Solve();
+
+  /*!
+   * \brief The x value that corresponds to zero in the coordinates of Polynomial()
+   */
+  inline double Origin() const
+  {
+    return this->fitted_origin;
+  }
+
+  /*!
+   * \brief The polynomial from the last successful Solve() in coordinates relative to Origin()
+   */
+  inline const tLeastSquaresPolynomial<Tdegree> &Polynomial() const
+  {
+    return this->polynomial;
+  }
+
+  inline double GetStandardDeviation() const
+  {
+    return this->polynomial.GetStandardDeviation();
+  }
+
+  inline double operator()(double x) const
+  {
+    return this->polynomial(x - this->fitted_origin);
+  }
+
+//----------------------------------------------------------------------
+// Private fields and methods
+//----------------------------------------------------------------------
+private:
+
+  std::vector<tSample> buffer;
+  size_t head;
+  size_t size;
+
+  tPolynomialMoments<Tdegree> moments;
+  double origin;
+  double scale;
+  size_t updates_since_rebuild;
+
+  tLeastSquaresPolynomial<Tdegree> polynomial;
+  double fitted_origin;
+
+  virtual const char *GetLogDescription() const
+  {
+    return "tSlidingWindowPolynomial";
+  }
+
+  inline tSample Normalized(const tSample &sample) const
+  {
+    return tSample((sample.X() - this->origin) / this->scale, sample.Y());
+  }
+
+  void RebuildMoments();
+
+};
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
+
+#include "rrlib/model_fitting/tSlidingWindowPolynomial.hpp"
+
+#endif
@@ -0,0 +1,180 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    tSlidingWindowPolynomial.hpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+
+#include "rrlib/logging/messages.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace declaration
+//----------------------------------------------------------------------
+namespace rrlib
+{
+namespace model_fitting
+{
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial constructors
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+tSlidingWindowPolynomial<Tdegree>::tSlidingWindowPolynomial(size_t capacity)
+  : buffer(capacity),
+    head(0),
+    size(0),
+    origin(0),
+    scale(1),
+    updates_since_rebuild(0),
+    fitted_origin(0)
+{
+  assert(capacity > Tdegree);
+}
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial Clear
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tSlidingWindowPolynomial<Tdegree>::Clear()
+{
+  this->head = 0;
+  this->size = 0;
+  this->moments.Clear();
+  this->updates_since_rebuild = 0;
+}
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial Push
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tSlidingWindowPolynomial<Tdegree>::Push(const tSample &sample)
+{
+  if (this->size == 0)
+  {
+    this->origin = sample.X();
+    this->scale = 1;
+  }
+  if (this->size == this->buffer.size())
+  {
+    this->Pop();
+  }
+
+  this->buffer[(this->head + this->size) % this->buffer.size()] = sample;
+  this->size++;
+  this->moments.Add(this->Normalized(sample));
+
+  // keep the normalized x values of the window in the order of [-1, 1]
+  double width = this->Newest().X() - this->Oldest().X();
+  if (++this->updates_since_rebuild >= this->buffer.size() ||
+      std::fabs(sample.X() - this->origin) > 4 * this->scale ||
+      (width > 0 && width < this->scale / 4))
+  {
+    this->RebuildMoments();
+  }
+}
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial Pop
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tSlidingWindowPolynomial<Tdegree>::Pop()
+{
+  assert(this->size > 0);
+  this->moments.Remove(this->Normalized(this->buffer[this->head]));
+  this->head = (this->head + 1) % this->buffer.size();
+  this->size--;
+  this->updates_since_rebuild++;
+}
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial Solve
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+const bool tSlidingWindowPolynomial<Tdegree>::Solve()
+{
+  if (this->size < Tdegree + 1)
+  {
+    RRLIB_LOG_PRINT(DEBUG_WARNING, "At least ", Tdegree + 1, " samples are needed to fit the polynomial!");
+    return false;
+  }
+  if (!this->polynomial.SolveNormalEquations(this->moments, 0, this->scale))
+  {
+    RRLIB_LOG_PRINT(DEBUG_WARNING, "Failed to fit polynomial to window.");
+    return false;
+  }
+  this->fitted_origin = this->origin;
+  return true;
+}
+
+//----------------------------------------------------------------------
+// tSlidingWindowPolynomial RebuildMoments
+//----------------------------------------------------------------------
+template <size_t Tdegree>
+void tSlidingWindowPolynomial<Tdegree>::RebuildMoments()
+{
+  this->origin = 0.5 * (this->Oldest().X() + this->Newest().X());
+  this->scale = this->Newest().X() > this->Oldest().X() ? 0.5 * (this->Newest().X() - this->Oldest().X()) : 1.0;
+  RRLIB_LOG_PRINT(DEBUG_VERBOSE_2, "Rebuilding power sums around ", this->origin, " with scale ", this->scale);
+
+  this->moments.Clear();
+  for (size_t i = 0; i < this->size; ++i)
+  {
+    this->moments.Add(this->Normalized(this->buffer[(this->head + i) % this->buffer.size()]));
+  }
+  this->updates_since_rebuild = 0;
+}
+
+//----------------------------------------------------------------------
+// End of namespace declaration
+//----------------------------------------------------------------------
+}
+}
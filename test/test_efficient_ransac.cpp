@@ -0,0 +1,193 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    test_efficient_ransac.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <random>
+
+#include "rrlib/logging/configuration.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tEfficientRansac.h"
+#include "rrlib/model_fitting/tRansacOrientedPlane3D.h"
+#include "rrlib/model_fitting/tRansacSphere3D.h"
+#include "rrlib/model_fitting/tRansacCylinder3D.h"
+#include "rrlib/model_fitting/tRansacCone3D.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::math;
+using namespace rrlib::model_fitting;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef tVector<3, double> tPoint;
+typedef tOrientedPoint3D<double> tSample;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const unsigned int cNUMBER_OF_SAMPLES_PER_SHAPE = 20000;
+const unsigned int cNUMBER_OF_OUTLIERS = 20000;
+const double cNOISE = 0.002;
+const double cMAX_ERROR = 0.01;
+const double cMAX_NORMAL_ANGLE = 0.3;
+const double cMAX_PARAMETER_ERROR = 0.01;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+int main(int argc, char **argv)
+{
+  rrlib::logging::default_log_description = basename(argv[0]);
+
+  rrlib::logging::SetDomainMaxMessageLevel(".", rrlib::logging::tLogLevel::DEBUG_VERBOSE_1);
+  rrlib::logging::SetDomainPrintsLocation(".", false);
+
+  std::mt19937 rng_engine(1);
+  std::normal_distribution<double> noise(0, cNOISE);
+  std::uniform_real_distribution<double> uniform(0, 1);
+
+  std::cout << "=== Scene with a floor, a sphere, a cylinder and a cone ===" << std::endl;
+
+  std::vector<tSample> samples;
+  for (size_t i = 0; i < cNUMBER_OF_SAMPLES_PER_SHAPE; ++i)
+  {
+    samples.push_back(tSample(tPoint(4 * uniform(rng_engine), 4 * uniform(rng_engine), noise(rng_engine)), tPoint(0, 0, 1)));
+
+    double phi = 2 * M_PI * uniform(rng_engine);
+    double theta = std::acos(2 * uniform(rng_engine) - 1);
+    tPoint direction(std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta));
+    samples.push_back(tSample(tPoint(2, 2, 0.5) + (0.4 + noise(rng_engine)) * direction, direction));
+
+    phi = 2 * M_PI * uniform(rng_engine);
+    direction = tPoint(std::cos(phi), std::sin(phi), 0);
+    samples.push_back(tSample(tPoint(3, 1, 1.5 * uniform(rng_engine)) + (0.2 + noise(rng_engine)) * direction, direction));
+
+    phi = 2 * M_PI * uniform(rng_engine);
+    direction = tPoint(std::cos(phi), std::sin(phi), 0);
+    double distance = 0.1 + uniform(rng_engine);
+    tPoint generator = std::cos(0.5) * tPoint(0, 0, -1) + std::sin(0.5) * direction;
+    tPoint normal = std::cos(0.5) * direction + std::sin(0.5) * tPoint(0, 0, 1);
+    samples.push_back(tSample(tPoint(1, 3, 1.2) + distance * generator + noise(rng_engine) * normal, normal));
+  }
+  for (size_t i = 0; i < cNUMBER_OF_OUTLIERS; ++i)
+  {
+    tPoint normal(uniform(rng_engine) - 0.5, uniform(rng_engine) - 0.5, uniform(rng_engine) - 0.5);
+    samples.push_back(tSample(tPoint(4 * uniform(rng_engine), 4 * uniform(rng_engine), 2 * uniform(rng_engine)), normal));
+  }
+
+  tEfficientRansac<> efficient_ransac;
+  efficient_ransac.AddShapeType(tRansacOrientedPlane3D<>(tAngleRadUnsigned(cMAX_NORMAL_ANGLE)));
+  efficient_ransac.AddShapeType(tRansacSphere3D<>(tAngleRadUnsigned(cMAX_NORMAL_ANGLE)));
+  efficient_ransac.AddShapeType(tRansacCylinder3D<>(tAngleRadUnsigned(cMAX_NORMAL_ANGLE)));
+  efficient_ransac.AddShapeType(tRansacCone3D<>(tAngleRadUnsigned(cMAX_NORMAL_ANGLE)));
+  efficient_ransac.SetSamples(samples.begin(), samples.end());
+
+  if (!efficient_ransac.Detect(cMAX_ERROR, cNUMBER_OF_SAMPLES_PER_SHAPE / 4))
+  {
+    std::cout << "No shapes detected!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::vector<tEfficientRansac<>::tDetectedShape> &shapes = efficient_ransac.DetectedShapes();
+  const double min_axis_cosine = std::cos(cMAX_PARAMETER_ERROR);
+  unsigned int number_of_planes = 0;
+  unsigned int number_of_spheres = 0;
+  unsigned int number_of_cylinders = 0;
+  unsigned int number_of_cones = 0;
+  bool parameters_correct = true;
+  for (size_t i = 0; i < shapes.size(); ++i)
+  {
+    std::cout << "Shape " << i << " with " << shapes[i].sample_indices.size() << " samples: ";
+    const tOrientedPointShape<> *shape = shapes[i].shape.get();
+    if (const tRansacOrientedPlane3D<> *plane = dynamic_cast<const tRansacOrientedPlane3D<> *>(shape))
+    {
+      std::cout << "plane with normal " << plane->Normal() << " through " << plane->Support() << std::endl;
+      number_of_planes++;
+      parameters_correct &= std::fabs(plane->Normal()[2]) >= min_axis_cosine
+                            && std::fabs(plane->Normal() * plane->Support()) <= cMAX_PARAMETER_ERROR;
+    }
+    else if (const tRansacSphere3D<> *sphere = dynamic_cast<const tRansacSphere3D<> *>(shape))
+    {
+      std::cout << "sphere with center " << sphere->Center() << " and radius " << sphere->Radius() << std::endl;
+      number_of_spheres++;
+      parameters_correct &= (sphere->Center() - tPoint(2, 2, 0.5)).Length() <= cMAX_PARAMETER_ERROR
+                            && std::fabs(sphere->Radius() - 0.4) <= cMAX_PARAMETER_ERROR;
+    }
+    else if (const tRansacCylinder3D<> *cylinder = dynamic_cast<const tRansacCylinder3D<> *>(shape))
+    {
+      std::cout << "cylinder with axis " << cylinder->AxisDirection() << " through " << cylinder->AxisPoint() << " and radius " << cylinder->Radius() << std::endl;
+      number_of_cylinders++;
+      tPoint axis_offset = cylinder->AxisPoint() - tPoint(3, 1, 0);
+      parameters_correct &= std::fabs(cylinder->AxisDirection()[2]) >= min_axis_cosine
+                            && (axis_offset - (axis_offset * cylinder->AxisDirection()) * cylinder->AxisDirection()).Length() <= cMAX_PARAMETER_ERROR
+                            && std::fabs(cylinder->Radius() - 0.2) <= cMAX_PARAMETER_ERROR;
+    }
+    else if (const tRansacCone3D<> *cone = dynamic_cast<const tRansacCone3D<> *>(shape))
+    {
+      std::cout << "cone with apex " << cone->Apex() << ", axis " << cone->AxisDirection() << " and half angle " << cone->HalfAngle() << std::endl;
+      number_of_cones++;
+      parameters_correct &= (cone->Apex() - tPoint(1, 3, 1.2)).Length() <= cMAX_PARAMETER_ERROR
+                            && -cone->AxisDirection()[2] >= min_axis_cosine
+                            && std::fabs(cone->HalfAngle() - 0.5) <= cMAX_PARAMETER_ERROR;
+    }
+  }
+
+  if (shapes.size() != 4 || number_of_planes != 1 || number_of_spheres != 1 || number_of_cylinders != 1 || number_of_cones != 1)
+  {
+    std::cout << "Expected one plane, sphere, cylinder and cone but found " << shapes.size() << " shapes!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!parameters_correct)
+  {
+    std::cout << "Shape parameters deviate from the ground truth by more than " << cMAX_PARAMETER_ERROR << "!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return EXIT_SUCCESS;
+}
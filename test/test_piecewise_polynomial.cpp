@@ -0,0 +1,251 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    test_piecewise_polynomial.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <random>
+
+#include "rrlib/highgui_wrapper/tWindow.h"
+
+#include "rrlib/logging/configuration.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tPiecewisePolynomial.h"
+#include "rrlib/model_fitting/tPolynomialMomentIndex.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::highgui;
+using namespace rrlib::math;
+using namespace rrlib::model_fitting;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const unsigned int cNUMBER_OF_SAMPLES = 1000;
+const unsigned int cDRAW_SEGMENT_STEPS = 20;
+const double cNOISE = 0.005;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+double Signal(double x)
+{
+  if (x < 0.3)
+  {
+    return 0.2 + 0.5 * x;
+  }
+  if (x < 0.55)
+  {
+    return 0.65 - 2 * (x - 0.45) * (x - 0.45);
+  }
+  if (x < 0.8)
+  {
+    return 0.3;
+  }
+  return 0.3 + 1.5 * (x - 0.8);
+}
+
+bool CheckSegments(const tPiecewisePolynomial<2> &piecewise_polynomial, double penalty)
+{
+  const double cBREAKPOINTS[] = { 0.3, 0.55, 0.8 };
+  const double cBREAKPOINT_TOLERANCE = 0.02;
+
+  const std::vector<tPiecewisePolynomial<2>::tSegment> &segments = piecewise_polynomial.Segments();
+  if (segments.size() != 4)
+  {
+    std::cout << "Expected 4 segments but found " << segments.size() << "!" << std::endl;
+    return false;
+  }
+
+  double cost = 0;
+  for (size_t i = 0; i < segments.size(); ++i)
+  {
+    const tPiecewisePolynomial<2>::tSegment &segment = segments[i];
+    cost += segment.residual_sum_of_squares + penalty;
+    if (i > 0 && std::fabs(segment.x_min - cBREAKPOINTS[i - 1]) > cBREAKPOINT_TOLERANCE)
+    {
+      std::cout << "Segment " << i << " starts at " << segment.x_min << " instead of " << cBREAKPOINTS[i - 1] << "!" << std::endl;
+      return false;
+    }
+
+    double x = 0.5 * (segment.x_min + segment.x_max);
+    double error = segment.polynomial(x - segment.x_min) - Signal(x);
+    if (std::fabs(error) > 3 * cNOISE)
+    {
+      std::cout << "Segment " << i << " deviates by " << error << " from the signal at " << x << "!" << std::endl;
+      return false;
+    }
+  }
+
+  if (std::fabs(piecewise_polynomial.Cost() - cost) > 1E-9 * cost)
+  {
+    std::cout << "Cost " << piecewise_polynomial.Cost() << " differs from the segment costs " << cost << "!" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool CheckMomentIndexFarFromOrigin(std::mt19937 &rng_engine)
+{
+  const double cX_OFFSET = 1E6;
+  std::normal_distribution<double> noise(0, cNOISE);
+
+  std::vector<tVec2d> data;
+  for (size_t i = 0; i < 10 * cNUMBER_OF_SAMPLES; ++i)
+  {
+    double x = static_cast<double>(i) / cNUMBER_OF_SAMPLES;
+    data.push_back(tVec2d(cX_OFFSET + x, 0.5 + 2 * x - 3 * x * x + noise(rng_engine)));
+  }
+  tPolynomialMomentIndex<2> index(data.begin(), data.end());
+
+  // a range within one block, one across two blocks and one across many
+  const size_t ranges[3][2] = { { 9980, 9990 }, { 5020, 5050 }, { 2000, 7000 } };
+  for (size_t i = 0; i < 3; ++i)
+  {
+    tPolynomial<2> polynomial;
+    double residual_sum_of_squares;
+    if (!index.Fit(ranges[i][0], ranges[i][1], polynomial, residual_sum_of_squares))
+    {
+      std::cout << "Could not fit samples [" << ranges[i][0] << ", " << ranges[i][1] << ")!" << std::endl;
+      return false;
+    }
+
+    double expected_residual_sum_of_squares = 0;
+    for (size_t k = ranges[i][0]; k < ranges[i][1]; ++k)
+    {
+      double residual = polynomial(data[k].X() - index.Origin()) - data[k].Y();
+      expected_residual_sum_of_squares += residual * residual;
+    }
+    double x = 0.5 * (data[ranges[i][0]].X() + data[ranges[i][1] - 1].X()) - cX_OFFSET;
+    double error = polynomial(cX_OFFSET + x - index.Origin()) - (0.5 + 2 * x - 3 * x * x);
+
+    std::cout << "Samples [" << ranges[i][0] << ", " << ranges[i][1] << "): residual sum of squares " << residual_sum_of_squares
+              << " (expected " << expected_residual_sum_of_squares << "), error at center " << error << std::endl;
+    if (std::fabs(residual_sum_of_squares - expected_residual_sum_of_squares) > 1E-3 * expected_residual_sum_of_squares || std::fabs(error) > 3 * cNOISE)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+int main(int argc, char **argv)
+{
+  rrlib::logging::default_log_description = basename(argv[0]);
+
+  rrlib::logging::SetDomainMaxMessageLevel(".", rrlib::logging::tLogLevel::DEBUG_VERBOSE_1);
+  rrlib::logging::SetDomainPrintsLocation(".", false);
+
+  tWindow &window = tWindow::GetInstance("Piecewise Polynomial Tests", 500, 500);
+
+  std::mt19937 rng_engine(1);
+  std::normal_distribution<double> noise(0, cNOISE);
+
+  std::vector<tVec2d> data;
+  for (size_t i = 0; i < cNUMBER_OF_SAMPLES; ++i)
+  {
+    double x = static_cast<double>(i) / cNUMBER_OF_SAMPLES;
+    data.push_back(tVec2d(x, Signal(x) + noise(rng_engine)));
+  }
+
+  std::cout << "=== Data points ===" << std::endl;
+
+  for (std::vector<tVec2d>::iterator it = data.begin(); it != data.end(); ++it)
+  {
+    window.DrawCircleNormalized(it->X(), it->Y(), 0.002, true);
+  }
+  window.Render();
+
+  std::cout << "=== Piecewise polynomial of degree 2 ===" << std::endl;
+
+  double penalty = 3 * cNOISE * cNOISE * std::log(cNUMBER_OF_SAMPLES);
+  tPiecewisePolynomial<2> piecewise_polynomial(data.begin(), data.end(), penalty, 10);
+
+  for (size_t i = 0; i < piecewise_polynomial.Segments().size(); ++i)
+  {
+    const tPiecewisePolynomial<2>::tSegment &segment = piecewise_polynomial.Segments()[i];
+    std::cout << "Segment " << i << ": [" << segment.x_min << ", " << segment.x_max << "], "
+              << segment.last - segment.first << " samples, residual sum of squares " << segment.residual_sum_of_squares << std::endl;
+
+    window.SetColor(i + 1);
+    double x = segment.x_min;
+    double y = piecewise_polynomial(x);
+    for (size_t k = 1; k < cDRAW_SEGMENT_STEPS + 1; ++k)
+    {
+      double new_x = segment.x_min + k * (segment.x_max - segment.x_min) / cDRAW_SEGMENT_STEPS;
+      double new_y = segment.polynomial(new_x - segment.x_min);
+      window.DrawLineNormalized(x, y, new_x, new_y);
+      x = new_x;
+      y = new_y;
+    }
+  }
+  window.Render();
+
+  if (!CheckSegments(piecewise_polynomial, penalty))
+  {
+    tWindow::ReleaseAllInstances();
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "=== Moment index over short ranges far from the origin ===" << std::endl;
+
+  if (!CheckMomentIndexFarFromOrigin(rng_engine))
+  {
+    std::cout << "Range fits of the moment index are inaccurate!" << std::endl;
+    tWindow::ReleaseAllInstances();
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  tWindow::ReleaseAllInstances();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+//
+// You received this file as part of RRLib
+// Robotics Research Library
+//
+// Copyright (C) Finroc GbR (finroc.org)
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along
+// with this program; if not, write to the Free Software Foundation, Inc.,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+//----------------------------------------------------------------------
+/*!\file    test_ransac_plane_3d.cpp
+ *
+ * \author  agent
+ *
+ * \date    2026-10-18
+ *
+ */
+//----------------------------------------------------------------------
+
+//----------------------------------------------------------------------
+// External includes (system with <>, local with "")
+//----------------------------------------------------------------------
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "rrlib/logging/configuration.h"
+
+//----------------------------------------------------------------------
+// Internal includes with ""
+//----------------------------------------------------------------------
+#include "rrlib/model_fitting/tRansacPlane3D.h"
+
+//----------------------------------------------------------------------
+// Debugging
+//----------------------------------------------------------------------
+#include <cassert>
+
+//----------------------------------------------------------------------
+// Namespace usage
+//----------------------------------------------------------------------
+using namespace rrlib::math;
+using namespace rrlib::model_fitting;
+
+//----------------------------------------------------------------------
+// Forward declarations / typedefs / enums
+//----------------------------------------------------------------------
+typedef tVector<3, double> tPoint;
+
+//----------------------------------------------------------------------
+// Const values
+//----------------------------------------------------------------------
+const size_t cIMAGE_SIZE = 6;
+const unsigned int cNUMBER_OF_HYPOTHESES = 3000;
+const double cMAX_ERROR = 0.01;
+
+//----------------------------------------------------------------------
+// Implementation
+//----------------------------------------------------------------------
+
+/*!
+ * Two planes meeting at a crease, so that no hypothesis reaches full support
+ */
+std::vector<tPoint> CreateCreasedImage(size_t width, size_t height)
+{
+  std::vector<tPoint> points;
+  for (size_t v = 0; v < height; ++v)
+  {
+    for (size_t u = 0; u < width; ++u)
+    {
+      double x = u + 0.1 * std::sin(1.7 * u + 2.3 * v);
+      double y = v + 0.1 * std::cos(2.9 * u + 1.1 * v);
+      points.push_back(tPoint(x, y, u < width / 2 ? 0.0 : x - width / 2));
+    }
+  }
+  return points;
+}
+
+int main(int argc, char **argv)
+{
+  rrlib::logging::default_log_description = basename(argv[0]);
+
+  rrlib::logging::SetDomainMaxMessageLevel(".", rrlib::logging::tLogLevel::DEBUG_VERBOSE_1);
+  rrlib::logging::SetDomainPrintsLocation(".", false);
+
+  std::cout << "=== RANSAC with small sampling windows ===" << std::endl;
+
+  // the windows reach far fewer distinct minimal sets than hypotheses are requested
+  std::vector<tPoint> image = CreateCreasedImage(cIMAGE_SIZE, cIMAGE_SIZE);
+  tRansacPlane3D<> plane;
+  plane.SetOrganizedSamples(image.data(), cIMAGE_SIZE, cIMAGE_SIZE);
+  plane.SetSamplingWindowRadius(1);
+  if (!plane.DoRANSAC(cNUMBER_OF_HYPOTHESES, 1.0, cMAX_ERROR) || plane.NumberOfInliers() < cIMAGE_SIZE * cIMAGE_SIZE / 2)
+  {
+    std::cout << "Failed to find a plane in the image!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Plane with normal " << plane.Normal() << " and " << plane.NumberOfInliers() << " inliers" << std::endl;
+
+  std::vector<tPoint> scan_line = CreateCreasedImage(cIMAGE_SIZE * cIMAGE_SIZE, 1);
+  plane.SetOrganizedSamples(scan_line.data(), scan_line.size(), 1);
+  if (!plane.DoRANSAC(cNUMBER_OF_HYPOTHESES, 1.0, cMAX_ERROR))
+  {
+    std::cout << "Failed to find a plane in the scan line!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Plane with normal " << plane.Normal() << " and " << plane.NumberOfInliers() << " inliers" << std::endl;
+
+  std::cout << "=== J-linkage with small sampling windows ===" << std::endl;
+
+  plane.SetOrganizedSamples(image.data(), cIMAGE_SIZE, cIMAGE_SIZE);
+  if (!plane.DoJLinkage(cNUMBER_OF_HYPOTHESES, cMAX_ERROR, cIMAGE_SIZE))
+  {
+    std::cout << "Failed to find structures in the image!" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::cout << "Found " << plane.Structures().size() << " structures" << std::endl;
+
+  std::cout << "=== Replacing organized samples ===" << std::endl;
+
+  // the same number of unorganized samples must not inherit the pixel maps of the image
+  plane.Initialize(scan_line.size());
+  plane.AddSamples(scan_line.begin(), scan_line.end());
+  if (plane.IsOrganized())
+  {
+    std::cout << "Unorganized samples are still treated as organized!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  plane.SetOrganizedSamples(image.data(), cIMAGE_SIZE, cIMAGE_SIZE);
+  plane.AddSample(tPoint(0, 0, 0));
+  if (plane.IsOrganized())
+  {
+    std::cout << "Adding a sample did not end the organized mode!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "OK" << std::endl;
+
+  return EXIT_SUCCESS;
+}